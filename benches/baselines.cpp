@@ -0,0 +1,106 @@
+#include <cstdint>
+#include <optional>
+#include <result/result.hpp>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if __has_include(<expected>)
+#include <expected>
+#endif
+
+#include "benches.hpp"
+#include "inputs.hpp"
+
+using namespace result;
+
+// The same fallible parse step written with each error-handling style. The step is kept out of
+// line so every style pays for crossing a call boundary, as real parsers do.
+namespace {
+    enum class Code : std::uint8_t { Ok, Invalid };
+
+    [[gnu::noinline]] Result<std::uint32_t, Code> parse_result(std::uint32_t input) {
+        if (input & 1) {
+            return Error<Code> {Code::Invalid};
+        }
+        return Ok<std::uint32_t> {input >> 1};
+    }
+
+    [[gnu::noinline]] Code parse_code(std::uint32_t input, std::uint32_t& output) {
+        if (input & 1) {
+            return Code::Invalid;
+        }
+        output = input >> 1;
+        return Code::Ok;
+    }
+
+    [[gnu::noinline]] std::optional<std::uint32_t> parse_optional(std::uint32_t input) {
+        if (input & 1) {
+            return std::nullopt;
+        }
+        return input >> 1;
+    }
+
+#if defined(__cpp_lib_expected)
+    [[gnu::noinline]] std::expected<std::uint32_t, Code> parse_expected(std::uint32_t input) {
+        if (input & 1) {
+            return std::unexpected(Code::Invalid);
+        }
+        return input >> 1;
+    }
+#endif
+
+#ifndef RESULT_NO_EXCEPTIONS
+    [[gnu::noinline]] std::uint32_t parse_throwing(std::uint32_t input) {
+        if (input & 1) {
+            throw std::invalid_argument("invalid input");
+        }
+        return input >> 1;
+    }
+#endif
+
+    template <typename Loop>
+    bench::Body sweep_body(unsigned error_percent, Loop loop) {
+        return [inputs = bench::make_inputs(error_percent), loop](std::size_t iterations) {
+            std::uint32_t sum = 0;
+            for (std::size_t i = 0; i < iterations; ++i) {
+                sum += loop(inputs[i % bench::InputSize]);
+            }
+            bench::do_not_optimize(sum);
+        };
+    }
+}
+
+void register_baseline_benchmarks(bench::Suite& suite) {
+    for (unsigned rate : bench::ErrorRates) {
+        std::string suffix = "/errors=" + std::to_string(rate) + "%";
+
+        suite.add("parse/result" + suffix, sweep_body(rate, [](std::uint32_t input) {
+            auto parsed = parse_result(input);
+            return parsed ? *parsed : 0u;
+        }));
+        suite.add("parse/error_code" + suffix, sweep_body(rate, [](std::uint32_t input) {
+            std::uint32_t output = 0;
+            return parse_code(input, output) == Code::Ok ? output : 0u;
+        }));
+        suite.add("parse/optional" + suffix, sweep_body(rate, [](std::uint32_t input) {
+            auto parsed = parse_optional(input);
+            return parsed ? *parsed : 0u;
+        }));
+#if defined(__cpp_lib_expected)
+        suite.add("parse/expected" + suffix, sweep_body(rate, [](std::uint32_t input) {
+            auto parsed = parse_expected(input);
+            return parsed ? *parsed : 0u;
+        }));
+#endif
+#ifndef RESULT_NO_EXCEPTIONS
+        suite.add("parse/exception" + suffix, sweep_body(rate, [](std::uint32_t input) {
+            try {
+                return parse_throwing(input);
+            } catch (const std::invalid_argument&) {
+                return 0u;
+            }
+        }));
+#endif
+    }
+}
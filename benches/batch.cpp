@@ -0,0 +1,129 @@
+#include <cstdint>
+#include <result/batch.hpp>
+#include <string>
+#include <vector>
+
+#include "benches.hpp"
+#include "inputs.hpp"
+
+using namespace result;
+
+// Each iteration processes a whole batch of bench::InputSize readings.
+namespace {
+    enum class SensorError : std::uint8_t { OutOfRange };
+
+    using Reading = Result<float, SensorError>;
+
+    std::vector<Reading> make_readings(unsigned error_percent) {
+        std::vector<Reading> readings;
+        readings.reserve(bench::InputSize);
+        for (std::uint32_t input : bench::make_inputs(error_percent)) {
+            if (input & 1) {
+                readings.emplace_back(Error<SensorError> {SensorError::OutOfRange});
+            } else {
+                readings.emplace_back(Ok<float> {static_cast<float>(input >> 8)});
+            }
+        }
+        return readings;
+    }
+
+    struct Batch {
+        explicit Batch(unsigned error_percent)
+            : readings(make_readings(error_percent)), values(bench::InputSize), status(batch::word_count(bench::InputSize)),
+              out(bench::InputSize) {
+            batch::split(readings, std::span<float>(values), std::span<std::uint64_t>(status));
+        }
+
+        batch::View<float> view() const { return {values, status}; }
+
+        std::vector<Reading> readings;
+        std::vector<float> values;
+        std::vector<std::uint64_t> status;
+        std::vector<float> out;
+    };
+
+    constexpr auto calibrate = [](float x) { return x * 0.25f - 40.0f; };
+
+    const char* isa_name(batch::Isa isa) {
+        switch (isa) {
+            case batch::Isa::Scalar:
+                return "scalar";
+            case batch::Isa::Sse2:
+                return "sse2";
+            case batch::Isa::Avx2:
+                return "avx2";
+            case batch::Isa::Avx512:
+                return "avx512";
+        }
+        return "unknown";
+    }
+
+    void register_per_element(bench::Suite& suite, const std::string& suffix, unsigned rate) {
+        suite.add("batch/count_errors/per_element" + suffix, [b = Batch(rate)](std::size_t iterations) {
+            for (std::size_t i = 0; i < iterations; ++i) {
+                bench::do_not_optimize(batch::count_errors(b.readings));
+            }
+        });
+        suite.add("batch/unwrap_or/per_element" + suffix, [b = Batch(rate)](std::size_t iterations) mutable {
+            for (std::size_t i = 0; i < iterations; ++i) {
+                for (std::size_t lane = 0; lane < bench::InputSize; ++lane) {
+                    b.out[lane] = b.readings[lane].has_value() ? *b.readings[lane] : 0.0f;
+                }
+                bench::clobber_memory();
+            }
+        });
+        suite.add("batch/map/per_element" + suffix, [b = Batch(rate)](std::size_t iterations) mutable {
+            for (std::size_t i = 0; i < iterations; ++i) {
+                for (std::size_t lane = 0; lane < bench::InputSize; ++lane) {
+                    if (b.readings[lane].has_value()) {
+                        b.out[lane] = calibrate(*b.readings[lane]);
+                    }
+                }
+                bench::clobber_memory();
+            }
+        });
+        suite.add("batch/partition/per_element" + suffix, [b = Batch(rate)](std::size_t iterations) {
+            for (std::size_t i = 0; i < iterations; ++i) {
+                bench::do_not_optimize(batch::partition(b.readings));
+            }
+        });
+    }
+
+    void register_kernels(bench::Suite& suite, const std::string& suffix, unsigned rate, batch::Isa isa) {
+        std::string name = std::string("/") + isa_name(isa) + suffix;
+        suite.add("batch/count_errors" + name, [b = Batch(rate), isa](std::size_t iterations) {
+            for (std::size_t i = 0; i < iterations; ++i) {
+                bench::do_not_optimize(batch::count_errors(b.view(), isa));
+            }
+        });
+        suite.add("batch/unwrap_or" + name, [b = Batch(rate), isa](std::size_t iterations) mutable {
+            for (std::size_t i = 0; i < iterations; ++i) {
+                batch::unwrap_or(b.view(), 0.0f, std::span<float>(b.out), isa);
+                bench::clobber_memory();
+            }
+        });
+        suite.add("batch/map" + name, [b = Batch(rate), isa](std::size_t iterations) mutable {
+            for (std::size_t i = 0; i < iterations; ++i) {
+                batch::map(b.view(), calibrate, std::span<float>(b.out), isa);
+                bench::clobber_memory();
+            }
+        });
+        suite.add("batch/partition" + name, [b = Batch(rate), isa](std::size_t iterations) {
+            for (std::size_t i = 0; i < iterations; ++i) {
+                bench::do_not_optimize(batch::partition(b.view(), isa));
+            }
+        });
+    }
+}
+
+void register_batch_benchmarks(bench::Suite& suite) {
+    for (unsigned rate : {1u, 10u, 50u}) {
+        std::string suffix = "/errors=" + std::to_string(rate) + "%";
+        register_per_element(suite, suffix, rate);
+        for (auto isa : {batch::Isa::Scalar, batch::Isa::Sse2, batch::Isa::Avx2, batch::Isa::Avx512}) {
+            if (isa <= batch::detected_isa()) {
+                register_kernels(suite, suffix, rate, isa);
+            }
+        }
+    }
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Minimal self-contained benchmark harness. Each benchmark body performs the requested number of
+// operations; the suite calibrates the count, keeps the fastest of several samples and prints the
+// results as JSON on stdout.
+namespace bench {
+    template <typename T>
+    inline void do_not_optimize(const T& value) {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    inline void clobber_memory() {
+        asm volatile("" : : : "memory");
+    }
+
+    using Body = std::function<void(std::size_t iterations)>;
+
+    struct Measurement {
+        std::string name;
+        std::size_t iterations;
+        double ns_per_op;
+    };
+
+    class Suite {
+    public:
+        void add(std::string name, Body body) { m_benchmarks.push_back({std::move(name), std::move(body)}); }
+
+        // Recognized arguments: --filter=<substring>, --min-time-ms=<milliseconds>, --samples=<count>.
+        int run(int argc, char** argv) {
+            std::string_view filter;
+            double min_time_ms = 50.0;
+            int samples = 5;
+            for (int i = 1; i < argc; ++i) {
+                std::string_view arg = argv[i];
+                if (arg.starts_with("--filter=")) {
+                    filter = arg.substr(9);
+                } else if (arg.starts_with("--min-time-ms=")) {
+                    min_time_ms = std::atof(argv[i] + 14);
+                } else if (arg.starts_with("--samples=")) {
+                    samples = std::max(1, std::atoi(argv[i] + 10));
+                } else {
+                    std::fprintf(stderr, "unknown argument: %s\n", argv[i]);
+                    return 1;
+                }
+            }
+
+            std::vector<Measurement> measurements;
+            for (auto& [name, body] : m_benchmarks) {
+                if (name.find(filter) == std::string::npos) {
+                    continue;
+                }
+                measurements.push_back(measure(name, body, min_time_ms, samples));
+            }
+            print_json(measurements);
+            return 0;
+        }
+
+    private:
+        struct Benchmark {
+            std::string name;
+            Body body;
+        };
+
+        static Measurement measure(const std::string& name, Body& body, double min_time_ms, int samples) {
+            using Clock = std::chrono::steady_clock;
+            auto time_ns = [&](std::size_t iterations) {
+                auto start = Clock::now();
+                body(iterations);
+                clobber_memory();
+                return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+            };
+
+            std::size_t iterations = 1;
+            double min_time_ns = min_time_ms * 1e6;
+            for (double elapsed = time_ns(iterations); elapsed < min_time_ns; elapsed = time_ns(iterations)) {
+                double scale = elapsed > 0 ? std::min(10.0, 1.2 * min_time_ns / elapsed) : 10.0;
+                iterations = std::max(iterations + 1, static_cast<std::size_t>(iterations * scale));
+            }
+
+            double best = time_ns(iterations);
+            for (int sample = 1; sample < samples; ++sample) {
+                best = std::min(best, time_ns(iterations));
+            }
+            return {name, iterations, best / static_cast<double>(iterations)};
+        }
+
+        static void print_json(const std::vector<Measurement>& measurements) {
+            std::printf("{\n  \"context\": {\"compiler\": \"%s\"},\n  \"benchmarks\": [\n", compiler());
+            for (std::size_t i = 0; i < measurements.size(); ++i) {
+                const Measurement& m = measurements[i];
+                std::printf("    {\"name\": \"%s\", \"iterations\": %zu, \"ns_per_op\": %.4f}%s\n", m.name.c_str(),
+                            m.iterations, m.ns_per_op, i + 1 < measurements.size() ? "," : "");
+            }
+            std::printf("  ]\n}\n");
+        }
+
+        static const char* compiler() {
+#if defined(__clang__)
+            return "clang " __clang_version__;
+#elif defined(__GNUC__)
+            return "gcc " __VERSION__;
+#else
+            return "unknown";
+#endif
+        }
+
+        std::vector<Benchmark> m_benchmarks;
+    };
+}
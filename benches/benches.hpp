@@ -0,0 +1,9 @@
+#pragma once
+
+#include "bench.hpp"
+
+void register_baseline_benchmarks(bench::Suite& suite);
+void register_batch_benchmarks(bench::Suite& suite);
+void register_operation_benchmarks(bench::Suite& suite);
+void register_pipeline_benchmarks(bench::Suite& suite);
+void register_return_benchmarks(bench::Suite& suite);
@@ -0,0 +1,37 @@
+// Synthetic translation unit for the code-size benchmark: many small functions that each unwrap
+// Results and read their errors, so most of its text is inlined Result accessors. It is compiled
+// with and without RESULT_NO_COLD_PATHS and the text sections of both objects are compared.
+#include <result/result.hpp>
+#include <string>
+#include <string_view>
+
+using namespace result;
+
+// Not in an anonymous namespace, which would give the call sites internal linkage.
+struct ParseError {
+    int line;
+    std::string message;
+};
+
+template <>
+struct result::ErrorDescription<ParseError> {
+    static std::string_view description(const ParseError& error) noexcept { return error.message; }
+};
+
+#define CALL_SITE_NAME(prefix, n) prefix##n
+#define CALL_SITE(n)                                                                                            \
+    int CALL_SITE_NAME(unwrap_site_, n)(const Result<int, std::string>& a, Result<long, ParseError>&& b,       \
+                                        const Result<void, int>& c) {                                          \
+        c.unwrap();                                                                                            \
+        return a.unwrap() + static_cast<int>(std::move(b).unwrap()) * (n);                                     \
+    }                                                                                                          \
+    std::size_t CALL_SITE_NAME(error_site_, n)(const Result<int, std::string>& a, Result<int, ParseError>&& b) { \
+        return a.error().size() + static_cast<std::size_t>(std::move(b).error().line) * (n);                   \
+    }
+
+#define CALL_SITES_4(n) CALL_SITE(n##0) CALL_SITE(n##1) CALL_SITE(n##2) CALL_SITE(n##3)
+#define CALL_SITES_16(n) CALL_SITES_4(n##0) CALL_SITES_4(n##1) CALL_SITES_4(n##2) CALL_SITES_4(n##3)
+#define CALL_SITES_64(n) CALL_SITES_16(n##0) CALL_SITES_16(n##1) CALL_SITES_16(n##2) CALL_SITES_16(n##3)
+#define CALL_SITES_256(n) CALL_SITES_64(n##0) CALL_SITES_64(n##1) CALL_SITES_64(n##2) CALL_SITES_64(n##3)
+
+CALL_SITES_256(1)
@@ -0,0 +1,55 @@
+# Usage: cmake -DOBJDUMP=<objdump> -DSPLIT=<object> -DINLINE=<object> -P code_size.cmake
+#
+# Prints the text size of the call-site translation unit compiled with cold failure paths (SPLIT)
+# and with RESULT_NO_COLD_PATHS (INLINE) as JSON. "hot" counts every .text section except
+# .text.unlikely*, which is where the compiler places cold code.
+
+function(text_sizes object out_hot out_cold)
+    execute_process(
+        COMMAND ${OBJDUMP} -h ${object}
+        OUTPUT_VARIABLE headers
+        RESULT_VARIABLE objdump_result
+    )
+    if(NOT objdump_result EQUAL 0)
+        message(FATAL_ERROR "objdump failed on ${object}")
+    endif()
+
+    set(hot 0)
+    set(cold 0)
+    string(REPLACE "\n" ";" lines "${headers}")
+    foreach(line IN LISTS lines)
+        if(line MATCHES "^ *[0-9]+ (\\.text[^ ]*) +([0-9a-f]+) ")
+            set(section "${CMAKE_MATCH_1}")
+            math(EXPR size "0x${CMAKE_MATCH_2}")
+            if(section MATCHES "^\\.text\\.unlikely")
+                math(EXPR cold "${cold} + ${size}")
+            else()
+                math(EXPR hot "${hot} + ${size}")
+            endif()
+        endif()
+    endforeach()
+    set(${out_hot} ${hot} PARENT_SCOPE)
+    set(${out_cold} ${cold} PARENT_SCOPE)
+endfunction()
+
+text_sizes(${SPLIT} split_hot split_cold)
+text_sizes(${INLINE} inline_hot inline_cold)
+math(EXPR saved "${inline_hot} - ${split_hot}")
+set(sign "")
+math(EXPR saved_permille "${saved} * 1000 / ${inline_hot}")
+if(saved_permille LESS 0)
+    set(sign "-")
+    math(EXPR saved_permille "-${saved_permille}")
+endif()
+math(EXPR saved_whole "${saved_permille} / 10")
+math(EXPR saved_tenths "${saved_permille} % 10")
+
+execute_process(COMMAND ${CMAKE_COMMAND} -E echo
+"{
+  \"benchmarks\": [
+    {\"name\": \"code_size/cold_paths\", \"hot_bytes\": ${split_hot}, \"cold_bytes\": ${split_cold}},
+    {\"name\": \"code_size/no_cold_paths\", \"hot_bytes\": ${inline_hot}, \"cold_bytes\": ${inline_cold}}
+  ],
+  \"hot_bytes_saved\": ${saved},
+  \"hot_percent_saved\": ${sign}${saved_whole}.${saved_tenths}
+}")
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace bench {
+    constexpr std::size_t InputSize = 4096;
+
+    // Inputs for error-rate sweeps: a deterministic pseudo-random sequence in which roughly
+    // error_percent of the entries are flagged as failures (the low bit is set).
+    inline std::vector<std::uint32_t> make_inputs(unsigned error_percent) {
+        std::vector<std::uint32_t> inputs;
+        inputs.reserve(InputSize);
+        std::uint32_t state = 0x2545f491;
+        for (std::size_t i = 0; i < InputSize; ++i) {
+            state = state * 1664525u + 1013904223u;
+            bool fail = (state >> 8) % 100 < error_percent;
+            inputs.push_back(((state >> 4) & ~1u) | (fail ? 1u : 0u));
+        }
+        return inputs;
+    }
+
+    constexpr unsigned ErrorRates[] = {0, 1, 10, 50, 100};
+}
@@ -0,0 +1,12 @@
+#include "bench.hpp"
+#include "benches.hpp"
+
+int main(int argc, char** argv) {
+    bench::Suite suite;
+    register_operation_benchmarks(suite);
+    register_pipeline_benchmarks(suite);
+    register_baseline_benchmarks(suite);
+    register_batch_benchmarks(suite);
+    register_return_benchmarks(suite);
+    return suite.run(argc, argv);
+}
@@ -0,0 +1,200 @@
+#include <cstdint>
+#include <result/result.hpp>
+#include <string>
+#include <vector>
+
+#include "benches.hpp"
+#include "inputs.hpp"
+
+using namespace result;
+
+namespace {
+    // As large as a diagnostic with an inline message buffer.
+    struct Diagnostic {
+        char message[112];
+        int line;
+        int column;
+    };
+
+    struct BoxedDiagnostic : Diagnostic {};
+}
+
+template <>
+struct result::BoxError<BoxedDiagnostic> : std::true_type {};
+
+namespace {
+    enum class Code : std::uint8_t { Invalid, Overflow };
+
+    using IntResult = Result<int, Code>;
+    using StringResult = Result<std::string, std::string>;
+    using VoidResult = Result<void, Code>;
+    using InlineDiagnosticResult = Result<int, Diagnostic>;
+    using BoxedDiagnosticResult = Result<int, BoxedDiagnostic>;
+
+    template <typename Make>
+    bench::Body construct_body(Make make) {
+        return [make](std::size_t iterations) {
+            for (std::size_t i = 0; i < iterations; ++i) {
+                auto value = make(i);
+                bench::do_not_optimize(value);
+            }
+        };
+    }
+
+    std::vector<IntResult> make_int_results(unsigned error_percent) {
+        std::vector<IntResult> results;
+        for (std::uint32_t input : bench::make_inputs(error_percent)) {
+            if (input & 1) {
+                results.emplace_back(Error<Code> {Code::Invalid});
+            } else {
+                results.emplace_back(Ok<int> {static_cast<int>(input >> 1)});
+            }
+        }
+        return results;
+    }
+
+    std::vector<StringResult> make_string_results(unsigned error_percent) {
+        std::vector<StringResult> results;
+        for (std::uint32_t input : bench::make_inputs(error_percent)) {
+            if (input & 1) {
+                results.emplace_back(Error<std::string> {"invalid input"});
+            } else {
+                results.emplace_back(Ok<std::string> {std::to_string(input)});
+            }
+        }
+        return results;
+    }
+
+    void register_construction(bench::Suite& suite) {
+        suite.add("construct/ok/int", construct_body([](std::size_t i) {
+            return IntResult(Ok<int> {static_cast<int>(i)});
+        }));
+        suite.add("construct/error/int", construct_body([](std::size_t) {
+            return IntResult(Error<Code> {Code::Overflow});
+        }));
+        suite.add("construct/ok/string", construct_body([](std::size_t) {
+            return StringResult(Ok<std::string> {"short"});
+        }));
+        suite.add("construct/error/string", construct_body([](std::size_t) {
+            return StringResult(Error<std::string> {"short"});
+        }));
+        suite.add("construct/in_place/string", construct_body([](std::size_t) {
+            return StringResult(in_place_ok, "short");
+        }));
+        suite.add("construct/ok/void", construct_body([](std::size_t) {
+            return VoidResult(Ok<> {});
+        }));
+        suite.add("construct/error/void", construct_body([](std::size_t) {
+            return VoidResult(Error<Code> {Code::Invalid});
+        }));
+        suite.add("construct/ok/inline_diagnostic", construct_body([](std::size_t i) {
+            return InlineDiagnosticResult(Ok<int> {static_cast<int>(i)});
+        }));
+        suite.add("construct/ok/boxed_diagnostic", construct_body([](std::size_t i) {
+            return BoxedDiagnosticResult(Ok<int> {static_cast<int>(i)});
+        }));
+        suite.add("construct/error/inline_diagnostic", construct_body([](std::size_t i) {
+            return InlineDiagnosticResult(Error<Diagnostic> {Diagnostic {"invalid input", static_cast<int>(i), 1}});
+        }));
+        suite.add("construct/error/boxed_diagnostic", construct_body([](std::size_t i) {
+            return BoxedDiagnosticResult(Error<BoxedDiagnostic> {{{"invalid input", static_cast<int>(i), 1}}});
+        }));
+    }
+
+    void register_copy_move(bench::Suite& suite) {
+        suite.add("copy/int", [results = make_int_results(10)](std::size_t iterations) {
+            for (std::size_t i = 0; i < iterations; ++i) {
+                IntResult copy = results[i % bench::InputSize];
+                bench::do_not_optimize(copy);
+            }
+        });
+        suite.add("copy/string", [results = make_string_results(10)](std::size_t iterations) {
+            for (std::size_t i = 0; i < iterations; ++i) {
+                StringResult copy = results[i % bench::InputSize];
+                bench::do_not_optimize(copy);
+            }
+        });
+        suite.add("move/string", [results = make_string_results(10)](std::size_t iterations) mutable {
+            for (std::size_t i = 0; i < iterations; ++i) {
+                StringResult& slot = results[i % bench::InputSize];
+                StringResult moved = std::move(slot);
+                bench::do_not_optimize(moved);
+                slot = std::move(moved);
+            }
+        });
+    }
+
+    void register_access(bench::Suite& suite) {
+        suite.add("unwrap/int", [results = make_int_results(0)](std::size_t iterations) {
+            int sum = 0;
+            for (std::size_t i = 0; i < iterations; ++i) {
+                sum += results[i % bench::InputSize].unwrap();
+            }
+            bench::do_not_optimize(sum);
+        });
+        suite.add("unwrap_unchecked/int", [results = make_int_results(0)](std::size_t iterations) {
+            int sum = 0;
+            for (std::size_t i = 0; i < iterations; ++i) {
+                sum += *results[i % bench::InputSize];
+            }
+            bench::do_not_optimize(sum);
+        });
+        suite.add("error/int", [results = make_int_results(100)](std::size_t iterations) {
+            int sum = 0;
+            for (std::size_t i = 0; i < iterations; ++i) {
+                sum += static_cast<int>(results[i % bench::InputSize].error());
+            }
+            bench::do_not_optimize(sum);
+        });
+        for (unsigned rate : bench::ErrorRates) {
+            suite.add("has_value/int/errors=" + std::to_string(rate) + "%",
+                      [results = make_int_results(rate)](std::size_t iterations) {
+                int sum = 0;
+                for (std::size_t i = 0; i < iterations; ++i) {
+                    const IntResult& result = results[i % bench::InputSize];
+                    sum += result ? *result : -1;
+                }
+                bench::do_not_optimize(sum);
+            });
+        }
+    }
+
+    void register_chains(bench::Suite& suite) {
+        for (unsigned rate : bench::ErrorRates) {
+            std::string suffix = "/errors=" + std::to_string(rate) + "%";
+            suite.add("map_chain/int" + suffix, [results = make_int_results(rate)](std::size_t iterations) {
+                for (std::size_t i = 0; i < iterations; ++i) {
+                    auto mapped = results[i % bench::InputSize]
+                        .map([](int x) { return x * 3; })
+                        .map([](int x) { return x + 1; })
+                        .map_error([](Code code) { return static_cast<int>(code); });
+                    bench::do_not_optimize(mapped);
+                }
+            });
+            suite.add("map_chain/string" + suffix, [results = make_string_results(rate)](std::size_t iterations) {
+                for (std::size_t i = 0; i < iterations; ++i) {
+                    auto mapped = results[i % bench::InputSize]
+                        .map([](const std::string& s) { return s.size(); })
+                        .map([](std::size_t n) { return n * 2; })
+                        .map_error([](const std::string& e) { return e.size(); });
+                    bench::do_not_optimize(mapped);
+                }
+            });
+        }
+        suite.add("map/void", [](std::size_t iterations) {
+            VoidResult result(Ok<> {});
+            for (std::size_t i = 0; i < iterations; ++i) {
+                bench::do_not_optimize(result);
+                auto mapped = result.map([i] { return static_cast<int>(i); });
+                bench::do_not_optimize(mapped);
+            }
+        });
+    }
+}
+
+void register_operation_benchmarks(bench::Suite& suite) {
+    register_construction(suite);
+    register_copy_move(suite);
+    register_access(suite);
+    register_chains(suite);
+}
@@ -0,0 +1,76 @@
+#include <cstdint>
+#include <result/result.hpp>
+#include <vector>
+
+#include "benches.hpp"
+#include "inputs.hpp"
+
+using namespace result;
+
+namespace {
+    enum class StageError : std::uint8_t { Invalid, Overflow };
+
+    // Every 16th input is an error.
+    std::vector<Result<std::uint32_t, StageError>> make_inputs() {
+        std::vector<Result<std::uint32_t, StageError>> inputs;
+        inputs.reserve(bench::InputSize);
+        for (std::uint32_t i = 0; i < bench::InputSize; ++i) {
+            if (i % 16 == 15) {
+                inputs.emplace_back(Error<StageError> {StageError::Invalid});
+            } else {
+                inputs.emplace_back(Ok<std::uint32_t> {i});
+            }
+        }
+        return inputs;
+    }
+
+    constexpr auto s0 = [](std::uint32_t x) { return x + 7; };
+    constexpr auto s1 = [](std::uint32_t x) { return x * 3; };
+    constexpr auto s2 = [](std::uint32_t x) { return x ^ 0x5a5a; };
+    constexpr auto s3 = [](std::uint32_t x) { return x >> 1; };
+    constexpr auto s4 = [](std::uint32_t x) { return x + (x << 2); };
+    constexpr auto s5 = [](std::uint32_t x) { return x - 11; };
+    constexpr auto s6 = [](std::uint32_t x) { return x * 5; };
+    constexpr auto s7 = [](std::uint32_t x) { return x ^ (x >> 3); };
+    constexpr auto s8 = [](std::uint32_t x) { return x + 13; };
+    constexpr auto s9 = [](std::uint32_t x) { return x | 1; };
+    constexpr auto to_code = [](StageError e) { return static_cast<int>(e) + 100; };
+
+    using Output = Result<std::uint32_t, int>;
+
+    Output eager_chain(const Result<std::uint32_t, StageError>& input) {
+        return input.map(s0).map(s1).map(s2).map(s3).map(s4).map(s5).map(s6).map(s7).map(s8).map(s9).map_error(to_code);
+    }
+
+    Output lazy_chain(const Result<std::uint32_t, StageError>& input) {
+        return input.lazy()
+            .map(s0).map(s1).map(s2).map(s3).map(s4).map(s5).map(s6).map(s7).map(s8).map(s9)
+            .map_error(to_code)
+            .run();
+    }
+
+    Output hand_written(const Result<std::uint32_t, StageError>& input) {
+        if (input.has_error()) {
+            return Error<int> {to_code(input.error_unchecked())};
+        }
+        std::uint32_t x = *input;
+        x = s9(s8(s7(s6(s5(s4(s3(s2(s1(s0(x))))))))));
+        return Ok<std::uint32_t> {x};
+    }
+
+    template <Output (*Chain)(const Result<std::uint32_t, StageError>&)>
+    bench::Body chain_body() {
+        return [inputs = make_inputs()](std::size_t iterations) {
+            for (std::size_t i = 0; i < iterations; ++i) {
+                Output output = Chain(inputs[i % bench::InputSize]);
+                bench::do_not_optimize(output);
+            }
+        };
+    }
+}
+
+void register_pipeline_benchmarks(bench::Suite& suite) {
+    suite.add("pipeline/map10/eager", chain_body<eager_chain>());
+    suite.add("pipeline/map10/lazy", chain_body<lazy_chain>());
+    suite.add("pipeline/map10/hand_written", chain_body<hand_written>());
+}
@@ -0,0 +1,89 @@
+#include <cstdint>
+#include <result/packed_result.hpp>
+#include <result/result.hpp>
+#include <string>
+#include <vector>
+
+#include "benches.hpp"
+#include "inputs.hpp"
+
+using namespace result;
+
+// Decoding a record whose every field goes through an out-of-line call, as it does when the field
+// readers live in another shared object. What is measured is the cost of returning each field's
+// Result and testing it in the caller.
+namespace {
+    enum class Code : std::uint8_t { Ok, Invalid };
+
+    constexpr std::size_t Fields = 4;
+
+    [[gnu::noinline]] Result<std::uint32_t, Code> read_result(const std::uint32_t* field) {
+        if (*field & 1) {
+            return Error<Code> {Code::Invalid};
+        }
+        return Ok<std::uint32_t> {*field >> 1};
+    }
+
+    [[gnu::noinline]] PackedResult<std::uint32_t, Code> read_packed(const std::uint32_t* field) {
+        if (*field & 1) {
+            return Error<Code> {Code::Invalid};
+        }
+        return Ok<std::uint32_t> {*field >> 1};
+    }
+
+    [[gnu::noinline]] Code read_code(const std::uint32_t* field, std::uint32_t& output) {
+        if (*field & 1) {
+            return Code::Invalid;
+        }
+        output = *field >> 1;
+        return Code::Ok;
+    }
+
+    template <typename Decoded, typename Read>
+    Decoded decode_record(const std::uint32_t* fields, Read read) {
+        std::uint32_t sum = 0;
+        for (std::size_t i = 0; i < Fields; ++i) {
+            RESULT_TRY(std::uint32_t value, read(fields + i));
+            sum += value;
+        }
+        return Ok<std::uint32_t> {sum};
+    }
+
+    // Records are consecutive groups of Fields inputs; error_percent applies to each field.
+    template <typename Decode>
+    bench::Body decode_body(unsigned error_percent, Decode decode) {
+        return [inputs = bench::make_inputs(error_percent), decode](std::size_t iterations) {
+            std::uint32_t sum = 0;
+            for (std::size_t i = 0; i < iterations; ++i) {
+                sum += decode(inputs.data() + (i * Fields) % (bench::InputSize - Fields + 1));
+            }
+            bench::do_not_optimize(sum);
+        };
+    }
+}
+
+void register_return_benchmarks(bench::Suite& suite) {
+    for (unsigned rate : bench::ErrorRates) {
+        std::string suffix = "/errors=" + std::to_string(rate) + "%";
+
+        suite.add("decode/result" + suffix, decode_body(rate, [](const std::uint32_t* fields) {
+            auto decoded = decode_record<Result<std::uint32_t, Code>>(fields, read_result);
+            return decoded ? *decoded : 0u;
+        }));
+        suite.add("decode/packed_result" + suffix, decode_body(rate, [](const std::uint32_t* fields) {
+            auto decoded = decode_record<PackedResult<std::uint32_t, Code>>(fields, read_packed);
+            return decoded ? *decoded : 0u;
+        }));
+        suite.add("decode/error_code" + suffix, decode_body(rate, [](const std::uint32_t* fields) {
+            std::uint32_t sum = 0;
+            for (std::size_t i = 0; i < Fields; ++i) {
+                std::uint32_t value = 0;
+                if (read_code(fields + i, value) != Code::Ok) {
+                    return 0u;
+                }
+                sum += value;
+            }
+            return sum;
+        }));
+    }
+}
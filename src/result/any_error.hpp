@@ -0,0 +1,393 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "result.hpp"
+
+namespace result {
+    class AnyError;
+
+    namespace detail {
+        // Operations on the payload of an AnyError. Each function receives the AnyError's buffer, which
+        // holds either the payload itself or a pointer to it on the heap.
+        struct AnyErrorVTable {
+            std::string_view (*description)(const void* buffer) noexcept;
+            bool (*equal)(const void* lhs, const void* rhs) noexcept;
+            void (*copy)(const void* from, void* to);
+            void (*move)(void* from, void* to) noexcept;
+            void (*destroy)(void* buffer) noexcept;
+            // Heap payloads are moved by stealing the pointer, which leaves the source empty.
+            bool heap;
+        };
+
+        template <typename T>
+        constexpr inline bool IsInPlaceType = false;
+
+        template <typename T>
+        constexpr inline bool IsInPlaceType<std::in_place_type_t<T>> = true;
+
+        // Copyability is checked when the error is stored rather than here, as asking whether a type that
+        // converts to AnyError is copyable would make the constraint depend on itself.
+        template <typename T>
+        concept ErasableError = !std::same_as<T, AnyError> && !IsInPlaceType<T> && std::is_object_v<T> &&
+                                !std::is_array_v<T> && !std::is_const_v<T>;
+
+        // A description that stays valid while its error is alive: a view or a reference into it.
+        template <typename T>
+        concept BorrowedDescription = requires(const T& error) {
+            ErrorDescription<T>::description(error);
+        } && (std::is_lvalue_reference_v<decltype(ErrorDescription<T>::description(std::declval<const T&>()))> ||
+              std::is_convertible_v<decltype(ErrorDescription<T>::description(std::declval<const T&>())), const char*> ||
+              std::is_same_v<std::remove_cv_t<decltype(ErrorDescription<T>::description(std::declval<const T&>()))>,
+                             std::string_view>);
+
+        template <typename T>
+        struct AnyErrorModel;
+    }
+
+    // A type-erased error. Small payloads, such as enums, error codes or pointers, live in an inline
+    // buffer; anything larger is moved to the heap. Descriptions and comparisons go through a static
+    // vtable per payload type, and the description comes from ErrorDescription<T> when it is defined.
+    class AnyError {
+    public:
+        constexpr static inline std::size_t InlineSize = sizeof(void*);
+
+        template <typename T>
+        constexpr static inline bool stores_inline = sizeof(T) <= InlineSize && alignof(T) <= alignof(void*) &&
+                                                     std::is_nothrow_move_constructible_v<T>;
+
+        template <typename T>
+            requires detail::ErasableError<std::decay_t<T>>
+        AnyError(T&& error) noexcept(stores_inline<std::decay_t<T>> && std::is_nothrow_constructible_v<std::decay_t<T>, T>)
+            : m_vtable(&detail::AnyErrorModel<std::decay_t<T>>::vtable) {
+            detail::AnyErrorModel<std::decay_t<T>>::construct(m_buffer, std::forward<T>(error));
+        }
+
+        template <typename T, typename... Args>
+            requires detail::ErasableError<T> && std::constructible_from<T, Args...>
+        explicit AnyError(std::in_place_type_t<T>, Args&&... args)
+            : m_vtable(&detail::AnyErrorModel<T>::vtable) {
+            detail::AnyErrorModel<T>::construct(m_buffer, std::forward<Args>(args)...);
+        }
+
+        AnyError(const AnyError& other) : m_vtable(other.m_vtable) { m_vtable->copy(other.m_buffer, m_buffer); }
+
+        AnyError(AnyError&& other) noexcept : m_vtable(other.m_vtable) {
+            m_vtable->move(other.m_buffer, m_buffer);
+            if (m_vtable->heap) {
+                other.m_vtable = &empty_vtable;
+            }
+        }
+
+        AnyError& operator=(const AnyError& other) {
+            if (this != &other) {
+                *this = AnyError(other);
+            }
+            return *this;
+        }
+
+        AnyError& operator=(AnyError&& other) noexcept {
+            if (this != &other) {
+                m_vtable->destroy(m_buffer);
+                std::construct_at(this, std::move(other));
+            }
+            return *this;
+        }
+
+        ~AnyError() { m_vtable->destroy(m_buffer); }
+
+        // A view into the error, valid until it is modified or destroyed.
+        [[nodiscard]] std::string_view description() const noexcept { return m_vtable->description(m_buffer); }
+
+        template <typename T>
+        [[nodiscard]] bool is() const noexcept {
+            return m_vtable == &detail::AnyErrorModel<T>::vtable;
+        }
+
+        template <typename T>
+        [[nodiscard]] T* get_if() noexcept {
+            return is<T>() ? detail::AnyErrorModel<T>::object(m_buffer) : nullptr;
+        }
+
+        template <typename T>
+        [[nodiscard]] const T* get_if() const noexcept {
+            return is<T>() ? detail::AnyErrorModel<T>::object(m_buffer) : nullptr;
+        }
+
+        // Errors are equal if they hold the same type and compare equal with its operator==. Payloads
+        // without one are only equal to themselves.
+        friend bool operator==(const AnyError& lhs, const AnyError& rhs) noexcept {
+            return lhs.m_vtable == rhs.m_vtable && lhs.m_vtable->equal(lhs.m_buffer, rhs.m_buffer);
+        }
+
+        // Self is deduced so that the constraint fails early for other types that find this by ADL, such
+        // as iterators into containers of AnyError.
+        template <std::same_as<AnyError> Self, typename T>
+            requires detail::ErasableError<T> && std::equality_comparable<T>
+        friend bool operator==(const Self& lhs, const T& rhs) noexcept(noexcept(rhs == rhs)) {
+            const T* payload = lhs.template get_if<T>();
+            return payload != nullptr && *payload == rhs;
+        }
+
+    private:
+        template <typename T>
+        friend struct detail::AnyErrorModel;
+
+        // Left behind by moving from an error held on the heap.
+        constexpr static inline detail::AnyErrorVTable empty_vtable {
+            [](const void*) noexcept { return std::string_view("moved-from error"); },
+            [](const void*, const void*) noexcept { return true; },
+            [](const void*, void*) {},
+            [](void*, void*) noexcept {},
+            [](void*) noexcept {},
+            false,
+        };
+
+        // Never null, which lets Results with a small Ok payload use null as their tag.
+        const detail::AnyErrorVTable* m_vtable;
+        alignas(void*) unsigned char m_buffer[InlineSize];
+    };
+
+    template <>
+    struct ErrorDescription<AnyError> {
+        static std::string_view description(const AnyError& error) noexcept { return error.description(); }
+    };
+
+    namespace detail {
+        template <typename T>
+        struct AnyErrorModel {
+            static_assert(std::is_copy_constructible_v<T> && std::is_nothrow_destructible_v<T>,
+                          "AnyError payloads must be copy constructible and nothrow destructible");
+
+            constexpr static inline bool Inline = AnyError::stores_inline<T>;
+
+            static T* object(void* buffer) noexcept {
+                if constexpr (Inline) {
+                    return std::launder(static_cast<T*>(buffer));
+                } else {
+                    return *std::launder(static_cast<T**>(buffer));
+                }
+            }
+
+            static const T* object(const void* buffer) noexcept { return object(const_cast<void*>(buffer)); }
+
+            template <typename... Args>
+            static void construct(void* buffer, Args&&... args) {
+                if constexpr (Inline) {
+                    std::construct_at(static_cast<T*>(buffer), std::forward<Args>(args)...);
+                } else {
+                    std::construct_at(static_cast<T**>(buffer), allocate(std::forward<Args>(args)...));
+                }
+            }
+
+            // Kept out of line so that constructing an error that fits inline stays small.
+            template <typename... Args>
+            RESULT_COLD static T* allocate(Args&&... args) {
+                return new T(std::forward<Args>(args)...);
+            }
+
+            static std::string_view description(const void* buffer) noexcept {
+                const T& error = *object(buffer);
+                if constexpr (HasErrorDescription<T>) {
+                    static_assert(BorrowedDescription<T>,
+                                  "AnyError needs ErrorDescription<T>::description() to return a view into the error "
+                                  "or a string with static storage");
+                    return std::string_view(ErrorDescription<T>::description(error));
+                } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+                    return std::string_view(error);
+                } else {
+                    return "unknown error";
+                }
+            }
+
+            static bool equal(const void* lhs, const void* rhs) noexcept {
+                if constexpr (std::equality_comparable<T>) {
+                    return *object(lhs) == *object(rhs);
+                } else {
+                    return object(lhs) == object(rhs);
+                }
+            }
+
+            static void copy(const void* from, void* to) { construct(to, *object(from)); }
+
+            static void move(void* from, void* to) noexcept {
+                if constexpr (Inline) {
+                    construct(to, std::move(*object(from)));
+                } else {
+                    std::construct_at(static_cast<T**>(to), object(from));
+                }
+            }
+
+            static void destroy(void* buffer) noexcept {
+                if constexpr (Inline) {
+                    std::destroy_at(object(buffer));
+                } else {
+                    delete object(buffer);
+                }
+            }
+
+            constexpr static inline AnyErrorVTable vtable {&description, &equal, &copy, &move, &destroy, !Inline};
+        };
+
+        template <typename OkType>
+        concept FitsInAnyError = sizeof(OkType) <= AnyError::InlineSize && alignof(OkType) <= alignof(AnyError) &&
+                                 std::is_nothrow_move_constructible_v<OkType> &&
+                                 std::is_nothrow_destructible_v<OkType>;
+
+        // Storage for Result<T, AnyError> with a small T. The Ok payload takes the place of the error's
+        // inline buffer and a null vtable pointer, which no AnyError holds, marks it active, so the Result
+        // is no larger than the AnyError alone.
+        template <typename OkType>
+        class AnyErrorStorage {
+            struct OkSlot {
+                template <typename... Args>
+                explicit OkSlot(std::in_place_t, Args&&... args) : value(std::forward<Args>(args)...) {}
+
+                template <typename F, typename... Args>
+                explicit OkSlot(InPlaceInvoke<OkIndex>, F&& f, Args&&... args)
+                    : value(std::invoke(std::forward<F>(f), std::forward<Args>(args)...)) {}
+
+                const AnyErrorVTable* vtable = nullptr;
+                OkType value;
+            };
+
+            static_assert(sizeof(OkSlot) == sizeof(AnyError));
+
+        public:
+            template <typename... Args>
+            explicit AnyErrorStorage(std::in_place_index_t<OkIndex>, Args&&... args) noexcept(
+                std::is_nothrow_constructible_v<OkType, Args...>)
+                : m_ok(std::in_place, std::forward<Args>(args)...) {}
+
+            template <typename... Args>
+            explicit AnyErrorStorage(std::in_place_index_t<ErrorIndex>, Args&&... args) noexcept(
+                std::is_nothrow_constructible_v<AnyError, Args...>)
+                : m_error(std::forward<Args>(args)...) {}
+
+            template <typename F, typename... Args>
+            explicit AnyErrorStorage(InPlaceInvoke<OkIndex> tag, F&& f, Args&&... args) noexcept(
+                std::is_nothrow_invocable_r_v<OkType, F, Args...>)
+                : m_ok(tag, std::forward<F>(f), std::forward<Args>(args)...) {}
+
+            template <typename F, typename... Args>
+            explicit AnyErrorStorage(InPlaceInvoke<ErrorIndex>, F&& f, Args&&... args) noexcept(
+                std::is_nothrow_invocable_r_v<AnyError, F, Args...>)
+                : m_error(std::invoke(std::forward<F>(f), std::forward<Args>(args)...)) {}
+
+            AnyErrorStorage(const AnyErrorStorage& other) requires(std::is_copy_constructible_v<OkType>) {
+                if (other.has_value()) {
+                    std::construct_at(std::addressof(m_ok), other.m_ok);
+                } else {
+                    std::construct_at(std::addressof(m_error), other.m_error);
+                }
+            }
+
+            AnyErrorStorage(AnyErrorStorage&& other) noexcept {
+                if (other.has_value()) {
+                    std::construct_at(std::addressof(m_ok), std::move(other.m_ok));
+                } else {
+                    std::construct_at(std::addressof(m_error), std::move(other.m_error));
+                }
+            }
+
+            AnyErrorStorage& operator=(const AnyErrorStorage& other) requires(std::is_copy_assignable_v<OkType>) {
+                if (has_value() && other.has_value()) {
+                    m_ok.value = other.m_ok.value;
+                } else if (!has_value() && !other.has_value()) {
+                    m_error = other.m_error;
+                } else if (other.has_value()) {
+                    emplace<OkIndex>(other.m_ok.value);
+                } else {
+                    emplace<ErrorIndex>(other.m_error);
+                }
+                return *this;
+            }
+
+            AnyErrorStorage& operator=(AnyErrorStorage&& other) noexcept(std::is_nothrow_move_assignable_v<OkType>)
+                requires(std::is_move_assignable_v<OkType>) {
+                if (has_value() && other.has_value()) {
+                    m_ok.value = std::move(other.m_ok.value);
+                } else if (!has_value() && !other.has_value()) {
+                    m_error = std::move(other.m_error);
+                } else if (other.has_value()) {
+                    emplace<OkIndex>(std::move(other.m_ok.value));
+                } else {
+                    emplace<ErrorIndex>(std::move(other.m_error));
+                }
+                return *this;
+            }
+
+            ~AnyErrorStorage() { destroy(); }
+
+            // Reads the vtable pointer through the object representation, as either member may be active.
+            [[nodiscard]] bool has_value() const noexcept {
+                const AnyErrorVTable* vtable;
+                std::memcpy(&vtable, static_cast<const void*>(this), sizeof(vtable));
+                return vtable == nullptr;
+            }
+
+            [[nodiscard]] OkType& ok() noexcept { return m_ok.value; }
+            [[nodiscard]] const OkType& ok() const noexcept { return m_ok.value; }
+            [[nodiscard]] AnyError& error() noexcept { return m_error; }
+            [[nodiscard]] const AnyError& error() const noexcept { return m_error; }
+
+            // Both payloads are nothrow movable, so a throwing construction happens into a temporary
+            // before the current payload is destroyed.
+            template <std::size_t Index, typename... Args>
+            auto& emplace(Args&&... args) noexcept(
+                std::is_nothrow_constructible_v<std::conditional_t<Index == OkIndex, OkType, AnyError>, Args...>) {
+                using NewType = std::conditional_t<Index == OkIndex, OkType, AnyError>;
+
+                if constexpr (std::is_nothrow_constructible_v<NewType, Args...>) {
+                    destroy();
+                    construct<Index>(std::forward<Args>(args)...);
+                } else {
+                    NewType tmp(std::forward<Args>(args)...);
+                    destroy();
+                    construct<Index>(std::move(tmp));
+                }
+                if constexpr (Index == OkIndex) {
+                    return m_ok.value;
+                } else {
+                    return m_error;
+                }
+            }
+
+        private:
+            template <std::size_t Index, typename... Args>
+            void construct(Args&&... args) {
+                if constexpr (Index == OkIndex) {
+                    std::construct_at(std::addressof(m_ok), std::in_place, std::forward<Args>(args)...);
+                } else {
+                    std::construct_at(std::addressof(m_error), std::forward<Args>(args)...);
+                }
+            }
+
+            void destroy() noexcept {
+                if (has_value()) {
+                    std::destroy_at(std::addressof(m_ok));
+                } else {
+                    std::destroy_at(std::addressof(m_error));
+                }
+            }
+
+            union {
+                OkSlot m_ok;
+                AnyError m_error;
+            };
+        };
+
+        template <FitsInAnyError OkType>
+        struct StorageFor<OkType, AnyError> {
+            using type = AnyErrorStorage<OkType>;
+        };
+    }
+}
@@ -0,0 +1,393 @@
+#pragma once
+
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "result.hpp"
+
+#if !defined(RESULT_NO_SIMD) && defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define RESULT_BATCH_X86 1
+#include <immintrin.h>
+#define RESULT_BATCH_TARGET_AVX2 gnu::target("avx2,bmi,bmi2,popcnt")
+#define RESULT_BATCH_TARGET_AVX512 gnu::target("avx512f,avx512vl,avx512bw,avx2,bmi,bmi2,popcnt")
+#else
+#define RESULT_BATCH_X86 0
+#endif
+
+// Kernels over batches of results with arithmetic payloads. A batch is stored as a bitmap plus
+// values: lane i holds values[i] when bit i of the status words is set and an error otherwise, which
+// is the layout split() produces. ResultVector::status_words() is such a bitmap, but a ResultVector
+// keeps its Ok values densely, so only the kernels that take a bare bitmap apply to it directly. The
+// kernels are compiled for several instruction sets and the best one supported by the running CPU
+// is picked at runtime; passing an explicit Isa selects a lower one, and one above detected_isa()
+// is lowered to it.
+namespace result::batch {
+    enum class Isa : std::uint8_t { Scalar, Sse2, Avx2, Avx512 };
+
+    template <typename T>
+    concept Lane = std::is_arithmetic_v<T> && !std::same_as<T, bool>;
+
+    template <Lane T>
+    struct View {
+        std::span<const T> values;
+        std::span<const std::uint64_t> status;
+
+        [[nodiscard]] constexpr std::size_t size() const noexcept { return values.size(); }
+    };
+
+    template <typename T>
+    View(std::span<T>, std::span<std::uint64_t>) -> View<std::remove_const_t<T>>;
+
+    struct Partition {
+        std::vector<std::size_t> oks;
+        std::vector<std::size_t> errors;
+    };
+
+    constexpr std::size_t word_count(std::size_t size) noexcept { return (size + 63) / 64; }
+
+    [[nodiscard]] inline Isa detected_isa() noexcept {
+#if RESULT_BATCH_X86
+        static const Isa isa = [] {
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vl") &&
+                __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("bmi2")) {
+                return Isa::Avx512;
+            }
+            if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi2") && __builtin_cpu_supports("popcnt")) {
+                return Isa::Avx2;
+            }
+            return Isa::Sse2;
+        }();
+        return isa;
+#else
+        return Isa::Scalar;
+#endif
+    }
+
+    namespace detail {
+        // The requested instruction set, or the best one the CPU has if it lacks the requested one.
+        [[nodiscard]] inline Isa usable(Isa isa) noexcept {
+            Isa detected = detected_isa();
+            return isa > detected ? detected : isa;
+        }
+
+        template <typename R>
+        concept ResultRange = std::ranges::contiguous_range<R> && std::ranges::sized_range<R> &&
+                              result::detail::IsResult<std::ranges::range_value_t<R>>;
+
+        [[gnu::always_inline]] inline std::size_t count_ok_kernel(const std::uint64_t* status, std::size_t size) noexcept {
+            std::size_t full = size / 64;
+            std::size_t count = 0;
+            for (std::size_t word = 0; word < full; ++word) {
+                count += static_cast<std::size_t>(std::popcount(status[word]));
+            }
+            if (size % 64 != 0) {
+                count += static_cast<std::size_t>(std::popcount(status[full] & ((std::uint64_t {1} << (size % 64)) - 1)));
+            }
+            return count;
+        }
+
+        template <typename T>
+        [[gnu::always_inline]] inline void unwrap_or_tail(const T* values, const std::uint64_t* status, std::size_t begin,
+                                                          std::size_t size, T fallback, T* out) noexcept {
+            for (std::size_t i = begin; i < size; ++i) {
+                bool ok = (status[i / 64] >> (i % 64)) & 1;
+                out[i] = ok ? values[i] : fallback;
+            }
+        }
+
+        // Writes f(values[i]) for every lane. Chunks of one status word have a fixed trip count, which
+        // lets the compiler vectorize f without a runtime alias check.
+        template <typename T, typename U, typename F>
+        [[gnu::always_inline]] inline void map_kernel(const T* __restrict values, std::size_t size, F& f, U* __restrict out) {
+            std::size_t i = 0;
+            for (; i + 64 <= size; i += 64) {
+                for (std::size_t lane = 0; lane < 64; ++lane) {
+                    out[i + lane] = static_cast<U>(f(values[i + lane]));
+                }
+            }
+            for (; i < size; ++i) {
+                out[i] = static_cast<U>(f(values[i]));
+            }
+        }
+
+        template <typename Index>
+        [[gnu::always_inline]] inline void partition_kernel(const std::uint64_t* status, std::size_t size, Index* oks,
+                                                            Index* errors) noexcept {
+            for (std::size_t word = 0; word < word_count(size); ++word) {
+                std::size_t remaining = size - word * 64;
+                std::uint64_t valid = remaining >= 64 ? ~std::uint64_t {0} : (std::uint64_t {1} << remaining) - 1;
+                std::uint64_t ok = status[word] & valid;
+                std::uint64_t error = ~status[word] & valid;
+                while (ok != 0) {
+                    *oks++ = word * 64 + static_cast<std::size_t>(std::countr_zero(ok));
+                    ok &= ok - 1;
+                }
+                while (error != 0) {
+                    *errors++ = word * 64 + static_cast<std::size_t>(std::countr_zero(error));
+                    error &= error - 1;
+                }
+            }
+        }
+
+        inline std::size_t count_ok_scalar(const std::uint64_t* status, std::size_t size) noexcept {
+            return count_ok_kernel(status, size);
+        }
+
+        template <typename T>
+        void unwrap_or_scalar(const T* values, const std::uint64_t* status, std::size_t size, T fallback, T* out) noexcept {
+            unwrap_or_tail(values, status, 0, size, fallback, out);
+        }
+
+        template <typename T, typename U, typename F>
+        void map_scalar(const T* values, std::size_t size, F& f, U* out) {
+            map_kernel(values, size, f, out);
+        }
+
+        inline void partition_scalar(const std::uint64_t* status, std::size_t size, std::size_t* oks, std::size_t* errors) noexcept {
+            partition_kernel(status, size, oks, errors);
+        }
+
+#if RESULT_BATCH_X86
+        // Lane masks are built by broadcasting the status bits and testing each lane's own bit. Eight
+        // byte lanes test a pair of 32-bit halves so that SSE2 does not need a 64-bit compare.
+        template <typename T>
+        void unwrap_or_sse2(const T* values, const std::uint64_t* status, std::size_t size, T fallback, T* out) noexcept {
+            if constexpr (sizeof(T) == 4 || sizeof(T) == 8) {
+                constexpr std::size_t Lanes = 16 / sizeof(T);
+                const __m128i bits = sizeof(T) == 4 ? _mm_set_epi32(8, 4, 2, 1) : _mm_set_epi32(2, 2, 1, 1);
+                __m128i fill;
+                T fills[Lanes];
+                for (T& lane : fills) {
+                    lane = fallback;
+                }
+                std::memcpy(&fill, fills, sizeof(fill));
+                std::size_t i = 0;
+                for (; i + Lanes <= size; i += Lanes) {
+                    int m = static_cast<int>((status[i / 64] >> (i % 64)) & ((1u << Lanes) - 1));
+                    __m128i mask = _mm_cmpeq_epi32(_mm_and_si128(_mm_set1_epi32(m), bits), bits);
+                    __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+                    __m128i blended = _mm_or_si128(_mm_and_si128(mask, value), _mm_andnot_si128(mask, fill));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), blended);
+                }
+                unwrap_or_tail(values, status, i, size, fallback, out);
+            } else {
+                unwrap_or_tail(values, status, 0, size, fallback, out);
+            }
+        }
+
+        [[RESULT_BATCH_TARGET_AVX2]] inline std::size_t count_ok_avx2(const std::uint64_t* status, std::size_t size) noexcept {
+            return count_ok_kernel(status, size);
+        }
+
+        template <typename T>
+        [[RESULT_BATCH_TARGET_AVX2]] void unwrap_or_avx2(const T* values, const std::uint64_t* status, std::size_t size,
+                                                         T fallback, T* out) noexcept {
+            if constexpr (sizeof(T) == 4 || sizeof(T) == 8) {
+                constexpr std::size_t Lanes = 32 / sizeof(T);
+                const __m256i bits = sizeof(T) == 4 ? _mm256_set_epi32(128, 64, 32, 16, 8, 4, 2, 1)
+                                                    : _mm256_set_epi64x(8, 4, 2, 1);
+                __m256i fill;
+                T fills[Lanes];
+                for (T& lane : fills) {
+                    lane = fallback;
+                }
+                std::memcpy(&fill, fills, sizeof(fill));
+                std::size_t i = 0;
+                for (; i + Lanes <= size; i += Lanes) {
+                    auto m = static_cast<std::int64_t>((status[i / 64] >> (i % 64)) & ((1u << Lanes) - 1));
+                    __m256i mask = sizeof(T) == 4 ? _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(static_cast<int>(m)), bits), bits)
+                                                  : _mm256_cmpeq_epi64(_mm256_and_si256(_mm256_set1_epi64x(m), bits), bits);
+                    __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_blendv_epi8(fill, value, mask));
+                }
+                unwrap_or_tail(values, status, i, size, fallback, out);
+            } else {
+                unwrap_or_tail(values, status, 0, size, fallback, out);
+            }
+        }
+
+        template <typename T, typename U, typename F>
+        [[RESULT_BATCH_TARGET_AVX2]] void map_avx2(const T* values, std::size_t size, F& f, U* out) {
+            map_kernel(values, size, f, out);
+        }
+
+        [[RESULT_BATCH_TARGET_AVX2]] inline void partition_avx2(const std::uint64_t* status, std::size_t size, std::size_t* oks,
+                                                                std::size_t* errors) noexcept {
+            partition_kernel(status, size, oks, errors);
+        }
+
+        // AVX-512 takes the status bits directly as the blend's mask register.
+        template <typename T>
+        [[RESULT_BATCH_TARGET_AVX512]] void unwrap_or_avx512(const T* values, const std::uint64_t* status, std::size_t size,
+                                                             T fallback, T* out) noexcept {
+            if constexpr (sizeof(T) == 4 || sizeof(T) == 8) {
+                constexpr std::size_t Lanes = 64 / sizeof(T);
+                __m512i fill;
+                T fills[Lanes];
+                for (T& lane : fills) {
+                    lane = fallback;
+                }
+                std::memcpy(&fill, fills, sizeof(fill));
+                std::size_t i = 0;
+                for (; i + Lanes <= size; i += Lanes) {
+                    std::uint64_t m = status[i / 64] >> (i % 64);
+                    __m512i value = _mm512_loadu_si512(values + i);
+                    __m512i blended = sizeof(T) == 4 ? _mm512_mask_blend_epi32(static_cast<__mmask16>(m), fill, value)
+                                                     : _mm512_mask_blend_epi64(static_cast<__mmask8>(m), fill, value);
+                    _mm512_storeu_si512(out + i, blended);
+                }
+                unwrap_or_tail(values, status, i, size, fallback, out);
+            } else {
+                unwrap_or_tail(values, status, 0, size, fallback, out);
+            }
+        }
+
+        template <typename T, typename U, typename F>
+        [[RESULT_BATCH_TARGET_AVX512]] void map_avx512(const T* values, std::size_t size, F& f, U* out) {
+            map_kernel(values, size, f, out);
+        }
+#endif
+    }
+
+    // Number of error lanes among the first size lanes of a status bitmap.
+    [[nodiscard]] inline std::size_t count_errors(std::span<const std::uint64_t> status, std::size_t size,
+                                                  Isa isa = detected_isa()) noexcept {
+        assert(status.size() >= word_count(size) && "status bitmap is shorter than the batch");
+#if RESULT_BATCH_X86
+        if (detail::usable(isa) >= Isa::Avx2) {
+            return size - detail::count_ok_avx2(status.data(), size);
+        }
+#endif
+        (void)isa;
+        return size - detail::count_ok_scalar(status.data(), size);
+    }
+
+    template <Lane T>
+    [[nodiscard]] std::size_t count_errors(View<T> batch, Isa isa = detected_isa()) noexcept {
+        return count_errors(batch.status, batch.size(), isa);
+    }
+
+    template <detail::ResultRange R>
+    [[nodiscard]] std::size_t count_errors(const R& results) noexcept {
+        std::size_t count = 0;
+        for (const auto& result : results) {
+            count += result.has_error() ? 1 : 0;
+        }
+        return count;
+    }
+
+    // out[i] is the value of lane i, or fallback where the lane holds an error.
+    template <Lane T>
+    void unwrap_or(View<T> batch, std::type_identity_t<T> fallback, std::span<T> out, Isa isa = detected_isa()) noexcept {
+        assert(out.size() >= batch.size() && "output is shorter than the batch");
+        assert(batch.status.size() >= word_count(batch.size()) && "status bitmap is shorter than the batch");
+        const T* values = batch.values.data();
+        const std::uint64_t* status = batch.status.data();
+        switch (detail::usable(isa)) {
+#if RESULT_BATCH_X86
+            case Isa::Avx512:
+                return detail::unwrap_or_avx512(values, status, batch.size(), fallback, out.data());
+            case Isa::Avx2:
+                return detail::unwrap_or_avx2(values, status, batch.size(), fallback, out.data());
+            case Isa::Sse2:
+                return detail::unwrap_or_sse2(values, status, batch.size(), fallback, out.data());
+#endif
+            default:
+                return detail::unwrap_or_scalar(values, status, batch.size(), fallback, out.data());
+        }
+    }
+
+    template <detail::ResultRange R, Lane T = typename std::ranges::range_value_t<R>::value_type>
+    void unwrap_or(const R& results, std::type_identity_t<T> fallback, std::span<T> out) noexcept {
+        assert(out.size() >= std::ranges::size(results) && "output is shorter than the batch");
+        std::size_t i = 0;
+        for (const auto& result : results) {
+            out[i++] = result.has_error() ? fallback : result.unwrap_unchecked();
+        }
+    }
+
+    // Applies f to every lane and returns the mapped batch, which shares the input's status words.
+    // Error lanes are mapped too so that the loop has no branches; f must be defined for whatever
+    // those slots hold (split() leaves them value-initialized).
+    template <Lane T, typename F, Lane U = std::remove_cvref_t<std::invoke_result_t<F&, const T&>>>
+    View<U> map(View<T> batch, F&& f, std::span<U> out, Isa isa = detected_isa()) {
+        assert(out.size() >= batch.size() && "output is shorter than the batch");
+        const T* values = batch.values.data();
+        switch (detail::usable(isa)) {
+#if RESULT_BATCH_X86
+            case Isa::Avx512:
+                detail::map_avx512(values, batch.size(), f, out.data());
+                break;
+            case Isa::Avx2:
+                detail::map_avx2(values, batch.size(), f, out.data());
+                break;
+#endif
+            default:
+                detail::map_scalar(values, batch.size(), f, out.data());
+                break;
+        }
+        return View<U> {out.first(batch.size()), batch.status};
+    }
+
+    // Indices of the Ok and error lanes, each in ascending order.
+    [[nodiscard]] inline Partition partition(std::span<const std::uint64_t> status, std::size_t size, Isa isa = detected_isa()) {
+        assert(status.size() >= word_count(size) && "status bitmap is shorter than the batch");
+        std::size_t errors = count_errors(status, size, isa);
+        Partition partition {std::vector<std::size_t>(size - errors), std::vector<std::size_t>(errors)};
+#if RESULT_BATCH_X86
+        if (detail::usable(isa) >= Isa::Avx2) {
+            detail::partition_avx2(status.data(), size, partition.oks.data(), partition.errors.data());
+            return partition;
+        }
+#endif
+        detail::partition_scalar(status.data(), size, partition.oks.data(), partition.errors.data());
+        return partition;
+    }
+
+    template <Lane T>
+    [[nodiscard]] Partition partition(View<T> batch, Isa isa = detected_isa()) {
+        return partition(batch.status, batch.size(), isa);
+    }
+
+    template <detail::ResultRange R>
+    [[nodiscard]] Partition partition(const R& results) {
+        Partition partition;
+        std::size_t errors = count_errors(results);
+        partition.oks.reserve(std::ranges::size(results) - errors);
+        partition.errors.reserve(errors);
+        std::size_t i = 0;
+        for (const auto& result : results) {
+            (result.has_error() ? partition.errors : partition.oks).push_back(i++);
+        }
+        return partition;
+    }
+
+    // Converts a range of results to the batch layout in one pass. Error lanes get a value-initialized
+    // slot; values must hold size elements and status word_count(size) words.
+    template <detail::ResultRange R, Lane T = typename std::ranges::range_value_t<R>::value_type>
+    View<T> split(const R& results, std::span<T> values, std::span<std::uint64_t> status) noexcept {
+        std::size_t size = std::ranges::size(results);
+        assert(values.size() >= size && "values are shorter than the batch");
+        assert(status.size() >= word_count(size) && "status bitmap is shorter than the batch");
+        auto it = std::ranges::begin(results);
+        for (std::size_t word = 0; word < word_count(size); ++word) {
+            std::uint64_t bits = 0;
+            std::size_t lanes = size - word * 64 < 64 ? size - word * 64 : 64;
+            for (std::size_t lane = 0; lane < lanes; ++lane, ++it) {
+                bool ok = !it->has_error();
+                values[word * 64 + lane] = ok ? it->unwrap_unchecked() : T {};
+                bits |= static_cast<std::uint64_t>(ok) << lane;
+            }
+            status[word] = bits;
+        }
+        return View<T> {values.first(size), status.first(word_count(size))};
+    }
+}
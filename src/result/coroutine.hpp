@@ -0,0 +1,197 @@
+#pragma once
+
+#include <coroutine>
+#include <cstddef>
+#include <new>
+#include <optional>
+
+#include "result.hpp"
+
+// Opt-in coroutine support: a function returning Result<T, E> may be written as a coroutine that
+// co_awaits other Results. Awaiting an Ok Result yields its value; awaiting an error completes the
+// coroutine immediately with that error, like RESULT_TRY. Results are returned with co_return:
+//
+//     Result<int, ParseError> sum(std::string_view a, std::string_view b) {
+//         int x = co_await parse(a);
+//         int y = co_await parse(b);
+//         co_return Ok{x + y};
+//     }
+//
+// These coroutines never suspend, so their frames are strictly nested in the caller. Compilers
+// that implement allocation elision remove the frame allocation entirely; otherwise frames are
+// recycled through a small per-thread cache so steady-state calls do not reach the allocator.
+namespace result {
+    namespace detail {
+        class FrameCache {
+            constexpr static inline std::size_t Granularity = 64;
+            constexpr static inline std::size_t BucketCount = 32;
+            constexpr static inline std::size_t MaxBlocksPerBucket = 16;
+
+            struct Block {
+                Block* next;
+            };
+
+        public:
+            FrameCache() = default;
+            FrameCache(const FrameCache&) = delete;
+            FrameCache& operator=(const FrameCache&) = delete;
+
+            ~FrameCache() {
+                for (std::size_t bucket = 0; bucket < BucketCount; ++bucket) {
+                    while (Block* block = m_free[bucket]) {
+                        m_free[bucket] = block->next;
+                        ::operator delete(block);
+                    }
+                }
+            }
+
+            static FrameCache& local() noexcept {
+                thread_local FrameCache cache;
+                return cache;
+            }
+
+            void* allocate(std::size_t size) {
+                std::size_t bucket = bucket_of(size);
+                if (bucket < BucketCount) {
+                    if (Block* block = m_free[bucket]) {
+                        m_free[bucket] = block->next;
+                        --m_count[bucket];
+                        return block;
+                    }
+                    return ::operator new((bucket + 1) * Granularity);
+                }
+                return ::operator new(size);
+            }
+
+            void deallocate(void* pointer, std::size_t size) noexcept {
+                std::size_t bucket = bucket_of(size);
+                if (bucket < BucketCount && m_count[bucket] < MaxBlocksPerBucket) {
+                    m_free[bucket] = ::new (pointer) Block {m_free[bucket]};
+                    ++m_count[bucket];
+                    return;
+                }
+                ::operator delete(pointer);
+            }
+
+        private:
+            static std::size_t bucket_of(std::size_t size) noexcept { return (size - 1) / Granularity; }
+
+            Block* m_free[BucketCount] = {};
+            std::size_t m_count[BucketCount] = {};
+        };
+
+        template <typename OkType, typename ErrorType>
+        class ResultPromise;
+
+        // Object returned from get_return_object(). The promise writes the coroutine's Result into
+        // it, and it converts to that Result once the coroutine has completed.
+        template <typename OkType, typename ErrorType>
+        class ResultReturnObject {
+        public:
+            explicit ResultReturnObject(ResultPromise<OkType, ErrorType>& promise) noexcept : m_promise(&promise) {
+                promise.m_slot = &m_value;
+            }
+
+            ResultReturnObject(ResultReturnObject&& other) noexcept : ResultReturnObject(*other.m_promise) {}
+
+            ResultReturnObject(const ResultReturnObject&) = delete;
+            ResultReturnObject& operator=(const ResultReturnObject&) = delete;
+
+            operator Result<OkType, ErrorType>() {
+                if (!m_value.has_value()) {
+                    // Either the compiler converted the return object before running the body, or
+                    // the coroutine flowed off its end without co_return.
+                    panic("Result coroutine completed without producing a Result");
+                }
+                return std::move(*m_value);
+            }
+
+        private:
+            ResultPromise<OkType, ErrorType>* m_promise;
+            std::optional<Result<OkType, ErrorType>> m_value;
+        };
+
+        template <typename Awaited>
+        class ResultAwaiter {
+            using AwaitedResult = std::remove_cvref_t<Awaited>;
+
+        public:
+            explicit ResultAwaiter(Awaited&& result) noexcept : m_result(std::forward<Awaited>(result)) {}
+
+            bool await_ready() const noexcept { return !m_result.has_error(); }
+
+            // Only reached for an error: the awaiting coroutine's promise takes the error, ends the
+            // coroutine and names the coroutine to continue with.
+            template <typename Promise>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) {
+                return handle.promise().short_circuit(handle, std::forward<Awaited>(m_result).error_unchecked());
+            }
+
+            decltype(auto) await_resume() {
+                if constexpr (std::is_void_v<typename AwaitedResult::value_type>) {
+                    return;
+                } else if constexpr (std::is_lvalue_reference_v<Awaited>) {
+                    return m_result.unwrap_unchecked();
+                } else {
+                    return typename AwaitedResult::value_type(std::move(m_result).unwrap_unchecked());
+                }
+            }
+
+        private:
+            Awaited&& m_result;
+        };
+
+        template <typename OkType, typename ErrorType>
+        class ResultPromise {
+        public:
+            ResultReturnObject<OkType, ErrorType> get_return_object() noexcept {
+                return ResultReturnObject<OkType, ErrorType>(*this);
+            }
+
+            std::suspend_never initial_suspend() const noexcept { return {}; }
+            std::suspend_never final_suspend() const noexcept { return {}; }
+
+            template <typename T>
+            requires(std::is_constructible_v<Result<OkType, ErrorType>, T&&>)
+            void return_value(T&& value) {
+                m_slot->emplace(std::forward<T>(value));
+            }
+
+            void unhandled_exception() {
+#ifdef RESULT_NO_EXCEPTIONS
+                panic("Unhandled exception in Result coroutine");
+#else
+                throw;
+#endif
+            }
+
+            template <typename E>
+            std::coroutine_handle<> short_circuit(std::coroutine_handle<ResultPromise> handle, E&& error) {
+                m_slot->emplace(in_place_error, std::forward<E>(error));
+                handle.destroy();
+                return std::noop_coroutine();
+            }
+
+            template <typename Awaited>
+            requires(IsResult<std::remove_cvref_t<Awaited>>)
+            ResultAwaiter<Awaited> await_transform(Awaited&& awaited) noexcept {
+                return ResultAwaiter<Awaited>(std::forward<Awaited>(awaited));
+            }
+
+            static void* operator new(std::size_t size) { return FrameCache::local().allocate(size); }
+            static void operator delete(void* pointer, std::size_t size) noexcept {
+                FrameCache::local().deallocate(pointer, size);
+            }
+
+        private:
+            friend class ResultReturnObject<OkType, ErrorType>;
+
+            std::optional<Result<OkType, ErrorType>>* m_slot = nullptr;
+        };
+    }
+}
+
+template <typename OkType, typename ErrorType, typename... Args>
+struct std::coroutine_traits<result::Result<OkType, ErrorType>, Args...> {
+    using promise_type = result::detail::ResultPromise<OkType, ErrorType>;
+};
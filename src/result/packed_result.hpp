@@ -0,0 +1,169 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#include "result.hpp"
+
+namespace result {
+    // Payloads a PackedResult can hold: trivially copyable values of 1, 2 or 4 bytes that round-trip
+    // through an unsigned integer of the same size, also during constant evaluation.
+    template <typename T>
+    concept Packable = std::is_trivially_copyable_v<T> && !std::is_pointer_v<T> && !std::is_member_pointer_v<T> &&
+                       (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4);
+
+    namespace detail {
+        template <std::size_t Size>
+        using PackedBits = std::conditional_t<Size == 1, std::uint8_t, std::conditional_t<Size == 2, std::uint16_t, std::uint32_t>>;
+
+        template <typename T>
+        [[nodiscard]] constexpr std::uint64_t pack(const T& value) noexcept {
+            return std::bit_cast<PackedBits<sizeof(T)>>(value);
+        }
+
+        template <typename T>
+        [[nodiscard]] constexpr T unpack(std::uint64_t word) noexcept {
+            return std::bit_cast<T>(static_cast<PackedBits<sizeof(T)>>(word));
+        }
+
+        // Invokes F with the Ok payload of a PackedResult, or with nothing when it has none.
+        template <typename F, typename OkType>
+        struct OkInvoke : std::invoke_result<F, OkType> {
+            constexpr static inline bool nothrow = std::is_nothrow_invocable_v<F, OkType>;
+        };
+
+        template <typename F>
+        struct OkInvoke<F, void> : std::invoke_result<F> {
+            constexpr static inline bool nothrow = std::is_nothrow_invocable_v<F>;
+        };
+    }
+
+    // A Result of small payloads kept in one std::uint64_t: the active payload in the low 32 bits and
+    // the tag in bit 63. It is trivially copyable and returned in a single register on 64-bit ABIs,
+    // has_value() is a sign test, and bits()/from_bits() carry it through interfaces that only take
+    // integers. There is no payload object to refer to, so accessors return by value; convert to
+    // Result for reference access and the remaining combinators.
+    template <typename OkType, typename ErrorType>
+        requires(std::is_void_v<OkType> || Packable<OkType>) && Packable<ErrorType>
+    class PackedResult {
+    public:
+        using value_type = OkType;
+        using error_type = ErrorType;
+
+        constexpr PackedResult(Ok<OkType> v) noexcept requires(!std::is_void_v<OkType>)
+            : m_word(OkBit | detail::pack(v.value)) {}
+
+        constexpr PackedResult(Ok<>) noexcept requires(std::is_void_v<OkType>) : m_word(OkBit) {}
+
+        constexpr PackedResult(Error<ErrorType> v) noexcept : m_word(detail::pack(v.value)) {}
+
+        constexpr PackedResult(const Result<OkType, ErrorType>& result) noexcept
+            : m_word(result.has_error() ? detail::pack(result.error_unchecked()) : ok_word(result)) {}
+
+        [[nodiscard]] constexpr static PackedResult from_bits(std::uint64_t bits) noexcept { return PackedResult(bits); }
+
+        [[nodiscard]] constexpr std::uint64_t bits() const noexcept { return m_word; }
+
+        constexpr operator Result<OkType, ErrorType>() const noexcept(
+            std::is_nothrow_constructible_v<Result<OkType, ErrorType>, InPlaceErrorTag, ErrorType> &&
+            (std::is_void_v<OkType> || std::is_nothrow_constructible_v<Result<OkType, ErrorType>, InPlaceOkTag, OkType>)) {
+            if (has_error()) {
+                return Result<OkType, ErrorType>(in_place_error, error_unchecked());
+            }
+            if constexpr (std::is_void_v<OkType>) {
+                return Result<OkType, ErrorType>(in_place_ok);
+            } else {
+                return Result<OkType, ErrorType>(in_place_ok, unwrap_unchecked());
+            }
+        }
+
+        [[nodiscard]] constexpr bool has_value() const noexcept { return (m_word & OkBit) != 0; }
+        [[nodiscard]] constexpr bool has_error() const noexcept { return !has_value(); }
+        [[nodiscard]] constexpr explicit operator bool() const noexcept { return has_value(); }
+
+        [[nodiscard]] constexpr OkType unwrap(RESULT_LOCATION) const {
+            if (has_error()) [[unlikely]] {
+                RESULT_STATS_COUNT(UnwrapFailed, ErrorType, location);
+                RESULT_PROBE(unwrap_failed, ErrorType, location);
+                detail::bad_unwrap<ErrorType>(error_unchecked());
+            }
+            return unwrap_unchecked();
+        }
+
+        [[nodiscard]] constexpr ErrorType error(RESULT_LOCATION) const {
+            if (has_value()) [[unlikely]] {
+                RESULT_STATS_COUNT(BadErrorAccess, ErrorType, location);
+                detail::bad_error_access();
+            }
+            return error_unchecked();
+        }
+
+        // Precondition: has_value().
+        [[nodiscard]] constexpr OkType unwrap_unchecked() const noexcept {
+            if constexpr (!std::is_void_v<OkType>) {
+                return detail::unpack<OkType>(m_word);
+            }
+        }
+
+        // Precondition: has_error().
+        [[nodiscard]] constexpr ErrorType error_unchecked() const noexcept { return detail::unpack<ErrorType>(m_word); }
+
+        [[nodiscard]] constexpr OkType operator*() const noexcept { return unwrap_unchecked(); }
+
+        template <typename F, typename NewOkType = typename detail::OkInvoke<F, OkType>::type>
+        [[nodiscard]] constexpr auto map(F&& f) const noexcept(detail::OkInvoke<F, OkType>::nothrow)
+            -> PackedResult<NewOkType, ErrorType> {
+            if (has_error()) {
+                return PackedResult<NewOkType, ErrorType>::from_bits(m_word);
+            }
+            if constexpr (std::is_void_v<NewOkType>) {
+                invoke_ok(std::forward<F>(f));
+                return Ok<> {};
+            } else {
+                return Ok<NewOkType> {invoke_ok(std::forward<F>(f))};
+            }
+        }
+
+        template <typename F, typename NewErrorType = std::invoke_result_t<F, ErrorType>>
+        [[nodiscard]] constexpr auto map_error(F&& f RESULT_AND_LOCATION) const
+            noexcept(std::is_nothrow_invocable_v<F, ErrorType>) -> PackedResult<OkType, NewErrorType> {
+            if (has_value()) {
+                return PackedResult<OkType, NewErrorType>::from_bits(m_word);
+            }
+            RESULT_PROBE(map_error, ErrorType, location);
+            return Error<NewErrorType>(std::invoke(std::forward<F>(f), error_unchecked()) RESULT_AND_LOCATION_ARG);
+        }
+
+    private:
+        template <typename O, typename E>
+            requires(std::is_void_v<O> || Packable<O>) && Packable<E>
+        friend class PackedResult;
+
+        constexpr static inline std::uint64_t OkBit = std::uint64_t {1} << 63;
+
+        constexpr explicit PackedResult(std::uint64_t word) noexcept : m_word(word) {}
+
+        constexpr static std::uint64_t ok_word([[maybe_unused]] const Result<OkType, ErrorType>& result) noexcept {
+            if constexpr (std::is_void_v<OkType>) {
+                return OkBit;
+            } else {
+                return OkBit | detail::pack(result.unwrap_unchecked());
+            }
+        }
+
+        template <typename F>
+        constexpr decltype(auto) invoke_ok(F&& f) const {
+            if constexpr (std::is_void_v<OkType>) {
+                return std::invoke(std::forward<F>(f));
+            } else {
+                return std::invoke(std::forward<F>(f), unwrap_unchecked());
+            }
+        }
+
+        std::uint64_t m_word;
+    };
+}
@@ -0,0 +1,257 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifndef RESULT_NO_EXCEPTIONS
+#include <exception>
+#endif
+
+#include "result.hpp"
+
+namespace result {
+    struct ParallelOptions {
+        // Worker threads including the calling one; 0 uses std::thread::hardware_concurrency().
+        std::size_t threads = 0;
+        // Elements per unit of work; 0 picks a size that gives each thread several chunks.
+        std::size_t chunk_size = 0;
+    };
+
+    namespace detail {
+        constexpr inline std::size_t NoError = std::numeric_limits<std::size_t>::max();
+
+        // Lowest-index error reported by any worker. Work past that index is skipped, and work before
+        // it still runs, since it may hold an earlier error; the outcome therefore matches a sequential
+        // run whatever the scheduling.
+        template <typename ErrorType>
+        class FirstError {
+        public:
+            [[nodiscard]] bool cancelled(std::size_t index) const noexcept {
+                return m_index.load(std::memory_order_relaxed) < index;
+            }
+
+            void report(std::size_t index, ErrorType&& error) {
+                std::lock_guard lock(m_mutex);
+                if (index < m_index.load(std::memory_order_relaxed)) {
+                    m_error.emplace(std::move(error));
+                    m_index.store(index, std::memory_order_relaxed);
+                }
+            }
+
+#ifndef RESULT_NO_EXCEPTIONS
+            // An exception cancels every remaining chunk and is rethrown by the calling thread.
+            void report_exception(std::exception_ptr exception) {
+                std::lock_guard lock(m_mutex);
+                if (!m_exception) {
+                    m_exception = std::move(exception);
+                }
+                m_index.store(0, std::memory_order_relaxed);
+            }
+
+            void rethrow_exception() const {
+                if (m_exception) {
+                    std::rethrow_exception(m_exception);
+                }
+            }
+#endif
+
+            [[nodiscard]] std::optional<ErrorType>& error() noexcept { return m_error; }
+
+        private:
+            std::atomic<std::size_t> m_index {NoError};
+            std::mutex m_mutex;
+            std::optional<ErrorType> m_error;
+#ifndef RESULT_NO_EXCEPTIONS
+            std::exception_ptr m_exception;
+#endif
+        };
+
+        // Runs body(chunk, begin, end) over [0, size) split into chunks that workers claim in
+        // ascending order, so a chunk is never started after a lower-indexed error cancels it.
+        template <typename ErrorType, typename Body>
+        void for_each_chunk(std::size_t size, const ParallelOptions& options, FirstError<ErrorType>& first_error, Body&& body) {
+            std::size_t threads = options.threads != 0 ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+            std::size_t chunk_size = options.chunk_size != 0 ? options.chunk_size : std::max<std::size_t>(size / (threads * 16), 256);
+            std::size_t chunks = (size + chunk_size - 1) / chunk_size;
+            threads = std::min(threads, chunks);
+
+            std::atomic<std::size_t> next_chunk {0};
+            auto work = [&] {
+                for (;;) {
+                    std::size_t chunk = next_chunk.fetch_add(1, std::memory_order_relaxed);
+                    std::size_t begin = chunk * chunk_size;
+                    if (chunk >= chunks || first_error.cancelled(begin)) {
+                        return;
+                    }
+#ifndef RESULT_NO_EXCEPTIONS
+                    try {
+                        body(chunk, begin, std::min(begin + chunk_size, size));
+                    } catch (...) {
+                        first_error.report_exception(std::current_exception());
+                        return;
+                    }
+#else
+                    body(chunk, begin, std::min(begin + chunk_size, size));
+#endif
+                }
+            };
+
+            if (threads > 1) {
+                std::vector<std::jthread> workers;
+                workers.reserve(threads - 1);
+                for (std::size_t i = 1; i < threads; ++i) {
+                    workers.emplace_back(work);
+                }
+                work();
+            } else {
+                work();
+            }
+#ifndef RESULT_NO_EXCEPTIONS
+            first_error.rethrow_exception();
+#endif
+        }
+
+        template <typename R>
+        concept ParallelRange = std::ranges::random_access_range<R> && std::ranges::sized_range<R>;
+
+        template <typename F, typename R>
+        using ElementResult = std::remove_cvref_t<std::invoke_result_t<F&, std::ranges::range_reference_t<R>>>;
+
+        template <typename F, typename R>
+        concept ResultFunction = ParallelRange<R> && std::invocable<F&, std::ranges::range_reference_t<R>> &&
+                                 IsResult<ElementResult<F, R>>;
+    }
+
+    // Writes the Ok value of f(input[i]) to output[i] in parallel and returns the filled prefix, or the
+    // error of the lowest failing index. Once an error is found no element past it is evaluated; the
+    // contents of output are unspecified on failure. An output smaller than the input raises
+    // std::length_error (or panics under RESULT_NO_EXCEPTIONS) before any work starts.
+    template <detail::ParallelRange R, typename T, typename F>
+        requires detail::ResultFunction<F, R>
+    Result<std::span<T>, typename detail::ElementResult<F, R>::error_type> try_transform(R&& input, std::span<T> output, F f,
+                                                                                          const ParallelOptions& options = {}) {
+        using ErrorType = typename detail::ElementResult<F, R>::error_type;
+        using Output = Result<std::span<T>, ErrorType>;
+        std::size_t size = std::ranges::size(input);
+        if (output.size() < size) {
+            detail::output_too_small("try_transform() output span is too small");
+        }
+
+        detail::FirstError<ErrorType> first_error;
+        auto first = std::ranges::begin(input);
+        detail::for_each_chunk(size, options, first_error, [&](std::size_t, std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end && !first_error.cancelled(i); ++i) {
+                auto result = std::invoke(f, first[static_cast<std::ranges::range_difference_t<R>>(i)]);
+                if (result.has_error()) {
+                    first_error.report(i, std::move(result).error_unchecked());
+                    return;
+                }
+                output[i] = std::move(result).unwrap_unchecked();
+            }
+        });
+
+        if (first_error.error()) {
+            return Output(in_place_error, std::move(*first_error.error()));
+        }
+        return Output(in_place_ok, output.first(size));
+    }
+
+    template <detail::ParallelRange R, typename F, typename T = typename detail::ElementResult<F, R>::value_type>
+        requires detail::ResultFunction<F, R> && std::default_initializable<T>
+    Result<std::vector<T>, typename detail::ElementResult<F, R>::error_type> try_transform(R&& input, F f,
+                                                                                           const ParallelOptions& options = {}) {
+        using Output = Result<std::vector<T>, typename detail::ElementResult<F, R>::error_type>;
+        std::vector<T> output(std::ranges::size(input));
+        auto filled = try_transform(input, std::span<T>(output), std::move(f), options);
+        if (filled.has_error()) {
+            return Output(in_place_error, std::move(filled).error_unchecked());
+        }
+        return Output(in_place_ok, std::move(output));
+    }
+
+    // Calls f, which returns Result<void, E>, on every element in parallel and returns the error of
+    // the lowest failing index.
+    template <detail::ParallelRange R, typename F>
+        requires detail::ResultFunction<F, R>
+    Result<void, typename detail::ElementResult<F, R>::error_type> try_for_each(R&& input, F f, const ParallelOptions& options = {}) {
+        using ErrorType = typename detail::ElementResult<F, R>::error_type;
+        detail::FirstError<ErrorType> first_error;
+        auto first = std::ranges::begin(input);
+        detail::for_each_chunk(std::ranges::size(input), options, first_error, [&](std::size_t, std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end && !first_error.cancelled(i); ++i) {
+                auto result = std::invoke(f, first[static_cast<std::ranges::range_difference_t<R>>(i)]);
+                if (result.has_error()) {
+                    first_error.report(i, std::move(result).error_unchecked());
+                    return;
+                }
+            }
+        });
+
+        if (first_error.error()) {
+            return Result<void, ErrorType>(in_place_error, std::move(*first_error.error()));
+        }
+        return Result<void, ErrorType>(Ok<> {});
+    }
+
+    // Folds the Ok values of f(input[i]) with op, or returns the error of the lowest failing index.
+    // Chunks are folded separately and then combined in index order, so op must be associative but
+    // need not be commutative. Each chunk starts from its first value converted to T, so the values
+    // must be implicitly convertible to T.
+    template <detail::ParallelRange R, typename T, typename Op, typename F>
+        requires detail::ResultFunction<F, R> &&
+                 std::convertible_to<typename detail::ElementResult<F, R>::value_type, T> &&
+                 std::convertible_to<std::invoke_result_t<Op&, T, typename detail::ElementResult<F, R>::value_type>, T> &&
+                 std::convertible_to<std::invoke_result_t<Op&, T, T>, T>
+    Result<T, typename detail::ElementResult<F, R>::error_type> try_reduce(R&& input, T init, Op op, F f,
+                                                                           const ParallelOptions& options = {}) {
+        using ErrorType = typename detail::ElementResult<F, R>::error_type;
+        using Output = Result<T, ErrorType>;
+        std::size_t size = std::ranges::size(input);
+        std::size_t chunk_size = options.chunk_size;
+        if (chunk_size == 0) {
+            std::size_t threads = options.threads != 0 ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+            chunk_size = std::max<std::size_t>(size / (threads * 16), 256);
+        }
+        std::vector<std::optional<T>> partials((size + chunk_size - 1) / chunk_size);
+
+        detail::FirstError<ErrorType> first_error;
+        auto first = std::ranges::begin(input);
+        ParallelOptions chunked = options;
+        chunked.chunk_size = chunk_size;
+        detail::for_each_chunk(size, chunked, first_error, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+            std::optional<T>& partial = partials[chunk];
+            for (std::size_t i = begin; i < end && !first_error.cancelled(i); ++i) {
+                auto result = std::invoke(f, first[static_cast<std::ranges::range_difference_t<R>>(i)]);
+                if (result.has_error()) {
+                    first_error.report(i, std::move(result).error_unchecked());
+                    return;
+                }
+                if (partial) {
+                    *partial = std::invoke(op, std::move(*partial), std::move(result).unwrap_unchecked());
+                } else {
+                    T seed = std::move(result).unwrap_unchecked();
+                    partial.emplace(std::move(seed));
+                }
+            }
+        });
+
+        if (first_error.error()) {
+            return Output(in_place_error, std::move(*first_error.error()));
+        }
+        for (std::optional<T>& partial : partials) {
+            init = std::invoke(op, std::move(init), std::move(*partial));
+        }
+        return Output(in_place_ok, std::move(init));
+    }
+}
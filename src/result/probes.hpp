@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+#include "type_name.hpp"
+
+// Define RESULT_ENABLE_PROBES to place Linux USDT (SystemTap SDT) probes, provider "result", at:
+//
+//     error          an Error is constructed
+//     unwrap_failed  unwrap() is called on an error, before the exception is thrown
+//     map_error      map_error() transforms an error
+//
+// Each probe is a single nop with a .note.stapsdt entry describing its arguments: the 64-bit hash
+// of the error type (detail::type_hash_v), the file name and the line of the call site. They cost
+// nothing until a tracer attaches, e.g.
+//
+//     bpftrace -e 'usdt:./server:result:error { @[str(arg1), arg2] = count(); }'
+//
+// On other platforms the probes expand to nothing.
+#if defined(__linux__) && (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__aarch64__))
+#define RESULT_PROBES_SUPPORTED
+
+// The note layout follows <sys/sdt.h> (version 3), which is not needed to build.
+#define RESULT_SDT_PROBE(name, arg_hash, arg_file, arg_line)                                                \
+    __asm__ __volatile__("990: nop\n"                                                               \
+                         ".pushsection .note.stapsdt, \"?\", \"note\"\n"                            \
+                         ".balign 4\n"                                                              \
+                         ".4byte 992f-991f, 994f-993f, 3\n"                                         \
+                         "991: .asciz \"stapsdt\"\n"                                                \
+                         "992: .balign 4\n"                                                         \
+                         "993: .8byte 990b\n"                                                       \
+                         ".8byte _.stapsdt.base\n"                                                  \
+                         ".8byte 0\n"                                                               \
+                         ".asciz \"result\"\n"                                                      \
+                         ".asciz \"" #name "\"\n"                                                   \
+                         ".asciz \"8@%[hash] 8@%[file] 4@%[line]\"\n"                               \
+                         "994: .balign 4\n"                                                         \
+                         ".popsection\n"                                                            \
+                         ".ifndef _.stapsdt.base\n"                                                 \
+                         ".pushsection .stapsdt.base, \"aG\", \"progbits\", .stapsdt.base, comdat\n" \
+                         ".weak _.stapsdt.base\n"                                                   \
+                         ".hidden _.stapsdt.base\n"                                                 \
+                         "_.stapsdt.base: .space 1\n"                                               \
+                         ".size _.stapsdt.base, 1\n"                                                \
+                         ".popsection\n"                                                            \
+                         ".endif\n"                                                                 \
+                         :                                                                          \
+                         : [hash] "nor"(static_cast<std::uint64_t>(arg_hash)),                      \
+                           [file] "nor"(static_cast<const char*>(arg_file)),                        \
+                           [line] "nor"(static_cast<std::uint32_t>(arg_line)))
+
+#define RESULT_PROBE(name, Type, location)                                                          \
+    do {                                                                                            \
+        if (!std::is_constant_evaluated()) {                                                        \
+            RESULT_SDT_PROBE(name, ::result::detail::type_hash_v<Type>, (location).file_name(), (location).line()); \
+        }                                                                                           \
+    } while (false)
+#else
+#define RESULT_PROBE(name, Type, location) ((void)0)
+#endif
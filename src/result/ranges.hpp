@@ -0,0 +1,294 @@
+#pragma once
+
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "result.hpp"
+
+namespace result {
+    namespace detail {
+        template <typename R>
+        using RangeResult = std::remove_cvref_t<std::ranges::range_reference_t<R>>;
+
+        template <typename R>
+        concept ResultInputRange = std::ranges::input_range<R> && IsResult<RangeResult<R>>;
+
+        // Elements are moved out when the range yields rvalues, or when it is an owning container
+        // passed as an rvalue. Views passed as rvalues still refer to someone else's elements.
+        template <typename R>
+        constexpr inline bool MovesElements = !std::is_lvalue_reference_v<std::ranges::range_reference_t<R>> ||
+                                              (!std::is_lvalue_reference_v<R> && !std::ranges::view<std::remove_cvref_t<R>>);
+
+        template <typename R, typename Element>
+        constexpr decltype(auto) forward_element(Element& element) noexcept {
+            if constexpr (MovesElements<R>) {
+                return std::move(element);
+            } else {
+                return (element);
+            }
+        }
+
+        template <typename Container, typename Value>
+        constexpr void append(Container& container, Value&& value) {
+            if constexpr (requires { container.push_back(std::forward<Value>(value)); }) {
+                container.push_back(std::forward<Value>(value));
+            } else {
+                container.insert(container.end(), std::forward<Value>(value));
+            }
+        }
+
+        // Yields lvalues to a reference's Ok value, and Ok values by value for prvalue Results.
+        struct UnwrapOk {
+            template <typename R>
+            constexpr decltype(auto) operator()(R&& result) const {
+                if constexpr (std::is_lvalue_reference_v<R>) {
+                    return (result.unwrap_unchecked());
+                } else {
+                    return typename std::remove_cvref_t<R>::value_type(std::move(result).unwrap_unchecked());
+                }
+            }
+        };
+
+        struct UnwrapError {
+            template <typename R>
+            constexpr decltype(auto) operator()(R&& result) const {
+                if constexpr (std::is_lvalue_reference_v<R>) {
+                    return (result.error_unchecked());
+                } else {
+                    return typename std::remove_cvref_t<R>::error_type(std::move(result).error_unchecked());
+                }
+            }
+        };
+    }
+
+    // Collects the Ok values of a range of Results into a container, or returns the first error.
+    // Iteration stops at that error, and the container reserves space up front when the range knows
+    // its size. A range of Result<void, E> collects to Result<void, E>.
+    template <typename Container = void, detail::ResultInputRange R>
+    constexpr auto collect(R&& range) {
+        using Element = detail::RangeResult<R>;
+        using ErrorType = typename Element::error_type;
+        using OkType = typename Element::value_type;
+
+        if constexpr (std::is_void_v<OkType>) {
+            static_assert(std::is_void_v<Container>, "a range of Result<void, E> collects to Result<void, E>");
+            for (auto&& element : range) {
+                if (element.has_error()) {
+                    return Result<void, ErrorType>(in_place_error, detail::forward_element<R>(element).error_unchecked());
+                }
+            }
+            return Result<void, ErrorType>(Ok<> {});
+        } else {
+            using Output = std::conditional_t<std::is_void_v<Container>, std::vector<OkType>, Container>;
+            Output output;
+            if constexpr (std::ranges::sized_range<R> && requires { output.reserve(std::size_t {}); }) {
+                output.reserve(static_cast<std::size_t>(std::ranges::size(range)));
+            }
+            for (auto&& element : range) {
+                if (element.has_error()) {
+                    return Result<Output, ErrorType>(in_place_error, detail::forward_element<R>(element).error_unchecked());
+                }
+                detail::append(output, detail::forward_element<R>(element).unwrap_unchecked());
+            }
+            return Result<Output, ErrorType>(in_place_ok, std::move(output));
+        }
+    }
+
+    // Like collect, but writes the Ok values into caller-provided storage and returns the filled
+    // prefix, so no allocation takes place. The output must have room for every element of a sized
+    // range, which is checked before anything is written, and for every Ok value of other ranges.
+    // Otherwise std::length_error is thrown (or the program panics under RESULT_NO_EXCEPTIONS);
+    // nothing is ever written past the end of output.
+    template <detail::ResultInputRange R, typename T>
+        requires(!std::is_void_v<typename detail::RangeResult<R>::value_type>)
+    constexpr Result<std::span<T>, typename detail::RangeResult<R>::error_type> try_collect(R&& range, std::span<T> output) {
+        using Output = Result<std::span<T>, typename detail::RangeResult<R>::error_type>;
+        constexpr const char* TooSmall = "try_collect() output span is too small";
+        if constexpr (std::ranges::sized_range<R>) {
+            if (static_cast<std::size_t>(std::ranges::size(range)) > output.size()) {
+                detail::output_too_small(TooSmall);
+            }
+        }
+        std::size_t count = 0;
+        for (auto&& element : range) {
+            if (element.has_error()) {
+                return Output(in_place_error, detail::forward_element<R>(element).error_unchecked());
+            }
+            if (count == output.size()) {
+                detail::output_too_small(TooSmall);
+            }
+            output[count++] = detail::forward_element<R>(element).unwrap_unchecked();
+        }
+        return Output(in_place_ok, output.first(count));
+    }
+
+    // Input view over a range of Results that ends right after the first error, so nothing past it
+    // is evaluated. Results produced on the fly are cached in the view and handed out as lvalues.
+    template <std::ranges::view V>
+        requires detail::ResultInputRange<V>
+    class UntilErrorView : public std::ranges::view_interface<UntilErrorView<V>> {
+        using Reference = std::ranges::range_reference_t<V>;
+        using ResultType = detail::RangeResult<V>;
+
+        constexpr static inline bool Caches = !std::is_lvalue_reference_v<Reference>;
+        using Cache = std::conditional_t<Caches, std::optional<ResultType>, std::remove_reference_t<Reference>*>;
+
+    public:
+        class Iterator {
+        public:
+            using iterator_concept = std::input_iterator_tag;
+            using value_type = ResultType;
+            using difference_type = std::ptrdiff_t;
+
+            Iterator() = default;
+            constexpr explicit Iterator(UntilErrorView* parent) noexcept : m_parent(parent) {}
+
+            constexpr std::conditional_t<Caches, ResultType&, Reference> operator*() const { return *m_parent->m_cache; }
+
+            constexpr Iterator& operator++() {
+                m_parent->advance();
+                return *this;
+            }
+
+            constexpr void operator++(int) { ++*this; }
+
+            friend constexpr bool operator==(const Iterator& it, std::default_sentinel_t) noexcept { return it.done(); }
+
+        private:
+            constexpr bool done() const noexcept { return !m_parent->m_cache; }
+
+            UntilErrorView* m_parent = nullptr;
+        };
+
+        UntilErrorView()
+            requires std::default_initializable<V>
+        = default;
+
+        constexpr explicit UntilErrorView(V base) : m_base(std::move(base)) {}
+
+        constexpr V base() const&
+            requires std::copy_constructible<V>
+        {
+            return m_base;
+        }
+
+        constexpr V base() && { return std::move(m_base); }
+
+        constexpr Iterator begin() {
+            m_current = std::ranges::begin(m_base);
+            fetch();
+            return Iterator(this);
+        }
+
+        constexpr std::default_sentinel_t end() const noexcept { return std::default_sentinel; }
+
+    private:
+        constexpr void fetch() {
+            if (m_current == std::ranges::end(m_base)) {
+                m_cache = Cache {};
+            } else if constexpr (Caches) {
+                m_cache.emplace(*m_current);
+            } else {
+                m_cache = std::addressof(*m_current);
+            }
+        }
+
+        constexpr void advance() {
+            if (m_cache->has_error()) {
+                m_cache = Cache {};
+            } else {
+                ++m_current;
+                fetch();
+            }
+        }
+
+        V m_base = V();
+        std::ranges::iterator_t<V> m_current {};
+        Cache m_cache {};
+    };
+
+    template <typename R>
+    UntilErrorView(R&&) -> UntilErrorView<std::views::all_t<R>>;
+
+    namespace views {
+        namespace detail {
+            // Pipeable adaptor: fn(range) and range | fn both apply it.
+            template <typename Fn>
+            struct Adaptor : Fn {
+                template <std::ranges::viewable_range R>
+                friend constexpr auto operator|(R&& range, const Adaptor& adaptor) {
+                    return adaptor(std::forward<R>(range));
+                }
+            };
+
+            struct Oks {
+                template <std::ranges::viewable_range R>
+                    requires result::detail::ResultInputRange<R>
+                constexpr auto operator()(R&& range) const {
+                    return std::views::all(std::forward<R>(range)) |
+                           std::views::filter([](const auto& element) { return !element.has_error(); }) |
+                           std::views::transform(result::detail::UnwrapOk {});
+                }
+            };
+
+            struct Errors {
+                template <std::ranges::viewable_range R>
+                    requires result::detail::ResultInputRange<R>
+                constexpr auto operator()(R&& range) const {
+                    return std::views::all(std::forward<R>(range)) |
+                           std::views::filter([](const auto& element) { return element.has_error(); }) |
+                           std::views::transform(result::detail::UnwrapError {});
+                }
+            };
+
+            struct UntilError {
+                template <std::ranges::viewable_range R>
+                    requires result::detail::ResultInputRange<R>
+                constexpr auto operator()(R&& range) const {
+                    return UntilErrorView(std::forward<R>(range));
+                }
+            };
+
+            template <typename F>
+            struct TransformResultClosure {
+                template <std::ranges::viewable_range R>
+                constexpr auto operator()(R&& range) const {
+                    return UntilErrorView(std::views::transform(std::forward<R>(range), f));
+                }
+
+                F f;
+            };
+
+            struct TransformResult {
+                template <std::ranges::viewable_range R, typename F>
+                constexpr auto operator()(R&& range, F&& f) const {
+                    return UntilErrorView(std::views::transform(std::forward<R>(range), std::forward<F>(f)));
+                }
+
+                template <typename F>
+                constexpr auto operator()(F&& f) const {
+                    return Adaptor<TransformResultClosure<std::decay_t<F>>> {{std::forward<F>(f)}};
+                }
+            };
+        }
+
+        // Ok values of a range of Results, skipping errors. Ranges that produce their Results on the
+        // fly evaluate each kept element twice, once to test it and once to read it.
+        inline constexpr detail::Adaptor<detail::Oks> oks {};
+
+        // Errors of a range of Results, skipping Ok values.
+        inline constexpr detail::Adaptor<detail::Errors> errors {};
+
+        // The Results of a range up to and including the first error.
+        inline constexpr detail::Adaptor<detail::UntilError> until_error {};
+
+        // Applies f, which returns a Result, to each element and stops after the first error.
+        inline constexpr detail::TransformResult transform_result {};
+    }
+}
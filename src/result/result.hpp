@@ -1,25 +1,133 @@
 #pragma once
 
-#include <optional>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+// Define RESULT_NO_EXCEPTIONS (implied by -fno-exceptions) to report misuse such as unwrapping an
+// error through the panic handler instead of throwing.
+#if !defined(RESULT_NO_EXCEPTIONS) && !defined(__cpp_exceptions)
+#define RESULT_NO_EXCEPTIONS
+#endif
+
+#ifndef RESULT_NO_EXCEPTIONS
+#include <stdexcept>
 #include <string>
-#include <variant>
+#endif
+
+// Failure paths (throwing from unwrap() or error(), panics) are kept out of line in a cold section so
+// that inlined accessors only carry a test and a call. Define RESULT_NO_COLD_PATHS to leave them to
+// the optimizer, e.g. to measure the difference.
+#if defined(RESULT_NO_COLD_PATHS)
+#define RESULT_COLD
+#elif defined(__GNUC__) || defined(__clang__)
+#define RESULT_COLD [[gnu::cold, gnu::noinline]]
+#elif defined(_MSC_VER)
+#define RESULT_COLD __declspec(noinline)
+#else
+#define RESULT_COLD
+#endif
+
+// With RESULT_ENABLE_STATS or RESULT_ENABLE_PROBES, Error's constructors, unwrap(), error() and
+// map_error() take their call site as a defaulted std::source_location parameter, which is
+// reported to the counters of result/stats.hpp and the probes of result/probes.hpp.
+#if defined(RESULT_ENABLE_STATS) || defined(RESULT_ENABLE_PROBES)
+#include <source_location>
+#define RESULT_LOCATION [[maybe_unused]] std::source_location location = std::source_location::current()
+#define RESULT_AND_LOCATION , RESULT_LOCATION
+#define RESULT_AND_LOCATION_ARG , location
+#else
+#define RESULT_LOCATION
+#define RESULT_AND_LOCATION
+#define RESULT_AND_LOCATION_ARG
+#endif
+
+#ifdef RESULT_ENABLE_STATS
+#include "stats.hpp"
+#define RESULT_STATS_COUNT(event, Type, location)                                                  \
+    (std::is_constant_evaluated() ? void() : ::result::stats::detail::count<Type>(::result::stats::Event::event, location))
+#else
+#define RESULT_STATS_COUNT(event, Type, location) ((void)0)
+#endif
+
+#ifdef RESULT_ENABLE_PROBES
+#include "probes.hpp"
+#else
+#define RESULT_PROBE(name, Type, location) ((void)0)
+#endif
 
 namespace result {
     template <typename T = void>
     struct Ok {
-        constexpr Ok(T v) noexcept : value(std::move(v)) {}
+        constexpr Ok(const T& v) noexcept(std::is_nothrow_copy_constructible_v<T>) : value(v) {}
+        constexpr Ok(T&& v) noexcept(std::is_nothrow_move_constructible_v<T>) : value(std::move(v)) {}
+
+        template <typename... Args>
+        constexpr explicit Ok(std::in_place_t, Args&&... args) noexcept(std::is_nothrow_constructible_v<T, Args...>)
+            : value(std::forward<Args>(args)...) {}
+
         T value;
     };
 
     template <>
     struct Ok<void> {};
 
+    template <typename T>
+    Ok(T) -> Ok<T>;
+
     template <typename T>
     struct Error {
-        constexpr Error(T v) noexcept : value(std::move(v)) {}
+        constexpr Error(const T& v RESULT_AND_LOCATION) noexcept(std::is_nothrow_copy_constructible_v<T>) : value(v) {
+            RESULT_STATS_COUNT(ErrorConstructed, T, location);
+            RESULT_PROBE(error, T, location);
+        }
+        constexpr Error(T&& v RESULT_AND_LOCATION) noexcept(std::is_nothrow_move_constructible_v<T>) : value(std::move(v)) {
+            RESULT_STATS_COUNT(ErrorConstructed, T, location);
+            RESULT_PROBE(error, T, location);
+        }
+
+        // A defaulted location cannot follow the pack, so these count under an unknown call site.
+        template <typename... Args>
+        constexpr explicit Error(std::in_place_t, Args&&... args) noexcept(std::is_nothrow_constructible_v<T, Args...>)
+            : value(std::forward<Args>(args)...) {
+            RESULT_STATS_COUNT(ErrorConstructed, T, std::source_location());
+            RESULT_PROBE(error, T, std::source_location());
+        }
+
         T value;
     };
 
+    template <typename T>
+    Error(T) -> Error<T>;
+
+    template <typename OkType, typename ErrorType>
+    class Result;
+
+    template <typename Source, typename OkStage, typename ErrorStage>
+    class Pipeline;
+
+    // Tags selecting the alternative a Result constructs in place from the remaining arguments.
+    struct InPlaceOkTag {
+        explicit InPlaceOkTag() = default;
+    };
+    constexpr inline InPlaceOkTag in_place_ok {};
+
+    struct InPlaceErrorTag {
+        explicit InPlaceErrorTag() = default;
+    };
+    constexpr inline InPlaceErrorTag in_place_error {};
+
     template <typename T>
     struct ErrorDescription;
 
@@ -28,224 +136,1732 @@ namespace result {
         { ErrorDescription<T>::description(error) } -> std::convertible_to<std::string_view>;
     };
 
+    namespace detail {
+        constexpr inline std::size_t BadUnwrapMessageCapacity = 256;
+
+        // Writes the message for unwrapping error into buffer, truncating the description to fit, and
+        // returns it. The message is null-terminated.
+        template <typename ErrorType>
+        std::string_view format_bad_unwrap(const ErrorType& error, char (&buffer)[BadUnwrapMessageCapacity]) {
+            constexpr std::string_view prefix = "Failed to unwrap Result";
+            std::memcpy(buffer, prefix.data(), prefix.size());
+            std::size_t size = prefix.size();
+            if constexpr (HasErrorDescription<ErrorType>) {
+                constexpr std::string_view separator = ": ";
+                auto&& description_source = ErrorDescription<ErrorType>::description(error);
+                std::string_view description = description_source;
+
+                std::size_t capacity = BadUnwrapMessageCapacity - 1 - prefix.size() - separator.size();
+                std::size_t length = description.size() < capacity ? description.size() : capacity;
+                std::memcpy(buffer + size, separator.data(), separator.size());
+                std::memcpy(buffer + size + separator.size(), description.data(), length);
+                size += separator.size() + length;
+            }
+            buffer[size] = '\0';
+            return {buffer, size};
+        }
+    }
+
+#ifndef RESULT_NO_EXCEPTIONS
+    // Thrown by unwrap() on an error. The message is only formatted, into an inline buffer, when
+    // what() is first called, so throwing allocates nothing beyond the exception itself.
     template <typename T>
     class BadUnwrapException : public std::exception {
     public:
-        BadUnwrapException(T e) : m_error(std::move(e)) { construct_message(); }
-        const char* what() const noexcept override { return m_message.c_str(); }
+        template <typename E>
+            requires std::constructible_from<T, E>
+        BadUnwrapException(E&& error) noexcept(std::is_nothrow_constructible_v<T, E>) : m_error(std::forward<E>(error)) {}
 
-    private:
-        void construct_message() requires(HasErrorDescription<T>) {
-            m_message = "Failed to unwrap Result: ";
-            m_message.append(ErrorDescription<T>::description(m_error));
-        }
+        // Copies format their own message on demand.
+        BadUnwrapException(const BadUnwrapException& other) noexcept(std::is_nothrow_copy_constructible_v<T>)
+            requires(std::is_copy_constructible_v<T>)
+            : std::exception(other), m_error(other.m_error) {}
+
+        BadUnwrapException(BadUnwrapException&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+            : std::exception(other), m_error(std::move(other.m_error)) {}
 
-        void construct_message() requires(!HasErrorDescription<T>) {
-            m_message = "Failed to unwrap Result";
+        const char* what() const noexcept override {
+            int state = Unformatted;
+            if (m_state.compare_exchange_strong(state, Formatting, std::memory_order_acquire)) {
+                detail::format_bad_unwrap(m_error, m_message);
+                m_state.store(Formatted, std::memory_order_release);
+            } else {
+                // Another thread got here first; formatting is a bounded copy, so wait for it.
+                while (m_state.load(std::memory_order_acquire) != Formatted) {
+                }
+            }
+            return m_message;
         }
 
+        [[nodiscard]] const T& error() const noexcept { return m_error; }
+
     private:
+        constexpr static inline int Unformatted = 0;
+        constexpr static inline int Formatting = 1;
+        constexpr static inline int Formatted = 2;
+
         T m_error;
-        std::string m_message;
+        mutable std::atomic<int> m_state {Unformatted};
+        mutable char m_message[detail::BadUnwrapMessageCapacity];
     };
+#endif
+
+    // Called with a description of the failure when a Result is misused in RESULT_NO_EXCEPTIONS
+    // mode. The handler must not return; if it does, the process is aborted.
+    using PanicHandler = void (*)(std::string_view message) noexcept;
+
+    namespace detail {
+        inline std::atomic<PanicHandler> panic_handler {nullptr};
+
+        [[noreturn]] RESULT_COLD inline void panic(std::string_view message) noexcept {
+            if (PanicHandler handler = panic_handler.load(std::memory_order_acquire)) {
+                handler(message);
+            }
+            std::fprintf(stderr, "%.*s\n", static_cast<int>(message.size()), message.data());
+            std::abort();
+        }
+
+        template <typename ErrorType>
+        [[noreturn]] RESULT_COLD void panic_bad_unwrap(const ErrorType& error) noexcept {
+            char buffer[BadUnwrapMessageCapacity];
+            panic(format_bad_unwrap(error, buffer));
+        }
+
+        template <typename ErrorType, typename E>
+        [[noreturn]] RESULT_COLD constexpr void bad_unwrap(E&& error) {
+#ifdef RESULT_NO_EXCEPTIONS
+            panic_bad_unwrap<ErrorType>(error);
+#else
+            throw BadUnwrapException<ErrorType>(std::forward<E>(error));
+#endif
+        }
+
+        [[noreturn]] RESULT_COLD inline void bad_error_access() {
+#ifdef RESULT_NO_EXCEPTIONS
+            panic("Failed to access error of a successful Result");
+#else
+            throw std::runtime_error("Failed to access error of a successful Result");
+#endif
+        }
+
+        // Raised by the algorithms that write into caller-provided storage when it cannot hold
+        // every value.
+        [[noreturn]] RESULT_COLD inline void output_too_small(const char* message) {
+#ifdef RESULT_NO_EXCEPTIONS
+            panic(message);
+#else
+            throw std::length_error(message);
+#endif
+        }
+    }
+
+    // Installs the handler used in RESULT_NO_EXCEPTIONS mode and returns the previous one. A null
+    // handler restores the default, which prints the message to stderr and aborts.
+    inline PanicHandler set_panic_handler(PanicHandler handler) noexcept {
+        return detail::panic_handler.exchange(handler, std::memory_order_acq_rel);
+    }
+
+    // Specialize for types that have a value no meaningful instance ever takes, e.g. an
+    // out-of-range enumerator or a sentinel handle. Result stores its discriminant in that value
+    // instead of a separate tag when the other alternative is an empty type (including
+    // Result<void, E>), so such a Result is exactly sizeof(T).
+    template <typename T>
+    struct NicheTraits;
+
+    template <typename T>
+    concept HasNiche = requires(const T& value) {
+        { NicheTraits<T>::niche() } noexcept -> std::same_as<T>;
+        { NicheTraits<T>::is_niche(value) } noexcept -> std::same_as<bool>;
+    };
+
+    // Specialize as std::true_type for error types too large to keep next to the Ok payload. Result
+    // then allocates such an error from a thread-local pool and stores only a pointer to it, so the
+    // Ok path stays small at the cost of an allocation per error. Defining
+    // RESULT_BOX_ERRORS_LARGER_THAN to a size in bytes boxes every error type larger than both that
+    // size and the Ok payload. Moving such an error hands over its block without allocating, so a
+    // Result holding a boxed error that has been moved from has no error object: it still reports
+    // has_error(), but may only be assigned to or destroyed, not read, compared or copied.
+    template <typename T>
+    struct BoxError : std::false_type {};
+
+    // Specialize as std::true_type for a type whose objects are always aligned to at least two bytes.
+    // A Result<T*, E> with an enum E of at most half a pointer then keeps the error in the low bit of
+    // the address and is exactly sizeof(T*). Like any specialization it must be visible wherever such
+    // a Result is used. Whether the Result holds an error cannot be tested in a constant expression.
+    template <typename T>
+    struct PointerNiche : std::false_type {};
+
+    namespace detail {
+        constexpr inline std::size_t OkIndex = 0;
+        constexpr inline std::size_t ErrorIndex = 1;
+
+        // Stands in for the missing payload of Result<void, E>.
+        struct Unit {};
+
+        // Selects the storage constructor that initializes alternative Index from the result of
+        // invoking a callable, so the returned prvalue is materialized directly in storage.
+        template <std::size_t Index>
+        struct InPlaceInvoke {
+            explicit InPlaceInvoke() = default;
+        };
+
+        // Casts value to the value category and constness of Self, like C++23 std::forward_like.
+        template <typename Self, typename T>
+        [[nodiscard]] constexpr auto&& forward_like(T& value) noexcept {
+            using Value = std::conditional_t<std::is_const_v<std::remove_reference_t<Self>>, const T, T>;
+            if constexpr (std::is_lvalue_reference_v<Self>) {
+                return static_cast<Value&>(value);
+            } else {
+                return static_cast<Value&&>(value);
+            }
+        }
+
+        // Initial stage of a Pipeline: passes the payload through unchanged.
+        struct Identity {
+            constexpr void operator()() const noexcept {}
+
+            template <typename T>
+            constexpr T&& operator()(T&& value) const noexcept {
+                return std::forward<T>(value);
+            }
+        };
+
+        // Calls Second with the result of First, or with no arguments if First returns void.
+        template <typename First, typename Second>
+        struct Composed {
+            [[no_unique_address]] First first;
+            [[no_unique_address]] Second second;
+
+            template <typename... Args>
+            constexpr decltype(auto) operator()(Args&&... args) {
+                if constexpr (std::is_void_v<std::invoke_result_t<First&, Args...>>) {
+                    std::invoke(first, std::forward<Args>(args)...);
+                    return std::invoke(second);
+                } else {
+                    return std::invoke(second, std::invoke(first, std::forward<Args>(args)...));
+                }
+            }
+        };
+
+        template <typename Stage, typename F>
+        constexpr auto compose(Stage&& stage, F&& f) {
+            if constexpr (std::is_same_v<std::remove_cvref_t<Stage>, Identity>) {
+                return std::decay_t<F>(std::forward<F>(f));
+            } else {
+                return Composed<std::remove_cvref_t<Stage>, std::decay_t<F>> {std::forward<Stage>(stage), std::forward<F>(f)};
+            }
+        }
+
+        // Tagged union holding exactly one of OkType or ErrorType. Unlike std::variant it has no
+        // valueless state, and it is trivially copyable/destructible whenever both payloads are.
+        template <typename OkType, typename ErrorType>
+        class TaggedStorage {
+            constexpr static inline bool TriviallyCopyConstructible =
+                std::is_trivially_copy_constructible_v<OkType> && std::is_trivially_copy_constructible_v<ErrorType>;
+            constexpr static inline bool TriviallyMoveConstructible =
+                std::is_trivially_move_constructible_v<OkType> && std::is_trivially_move_constructible_v<ErrorType>;
+            constexpr static inline bool TriviallyDestructible =
+                std::is_trivially_destructible_v<OkType> && std::is_trivially_destructible_v<ErrorType>;
+            constexpr static inline bool TriviallyCopyAssignable = TriviallyCopyConstructible && TriviallyDestructible &&
+                std::is_trivially_copy_assignable_v<OkType> && std::is_trivially_copy_assignable_v<ErrorType>;
+            constexpr static inline bool TriviallyMoveAssignable = TriviallyMoveConstructible && TriviallyDestructible &&
+                std::is_trivially_move_assignable_v<OkType> && std::is_trivially_move_assignable_v<ErrorType>;
+
+            constexpr static inline bool CopyConstructible =
+                std::is_copy_constructible_v<OkType> && std::is_copy_constructible_v<ErrorType>;
+            constexpr static inline bool MoveConstructible =
+                std::is_move_constructible_v<OkType> && std::is_move_constructible_v<ErrorType>;
+            constexpr static inline bool NothrowCopyConstructible =
+                std::is_nothrow_copy_constructible_v<OkType> && std::is_nothrow_copy_constructible_v<ErrorType>;
+            constexpr static inline bool NothrowMoveConstructible =
+                std::is_nothrow_move_constructible_v<OkType> && std::is_nothrow_move_constructible_v<ErrorType>;
+
+        public:
+            template <typename... Args>
+            constexpr explicit TaggedStorage(std::in_place_index_t<OkIndex>, Args&&... args) noexcept(
+                std::is_nothrow_constructible_v<OkType, Args...>)
+                : m_ok(std::forward<Args>(args)...), m_has_value(true) {}
+
+            template <typename... Args>
+            constexpr explicit TaggedStorage(std::in_place_index_t<ErrorIndex>, Args&&... args) noexcept(
+                std::is_nothrow_constructible_v<ErrorType, Args...>)
+                : m_error(std::forward<Args>(args)...), m_has_value(false) {}
+
+            template <typename F, typename... Args>
+            constexpr explicit TaggedStorage(InPlaceInvoke<OkIndex>, F&& f, Args&&... args) noexcept(
+                std::is_nothrow_invocable_r_v<OkType, F, Args...>)
+                : m_ok(std::invoke(std::forward<F>(f), std::forward<Args>(args)...)), m_has_value(true) {}
+
+            template <typename F, typename... Args>
+            constexpr explicit TaggedStorage(InPlaceInvoke<ErrorIndex>, F&& f, Args&&... args) noexcept(
+                std::is_nothrow_invocable_r_v<ErrorType, F, Args...>)
+                : m_error(std::invoke(std::forward<F>(f), std::forward<Args>(args)...)), m_has_value(false) {}
+
+            constexpr TaggedStorage(const TaggedStorage&) requires(TriviallyCopyConstructible) = default;
+            constexpr TaggedStorage(const TaggedStorage& other) noexcept(NothrowCopyConstructible)
+                requires(CopyConstructible && !TriviallyCopyConstructible)
+                : m_has_value(other.m_has_value) {
+                if (m_has_value) {
+                    std::construct_at(std::addressof(m_ok), other.m_ok);
+                } else {
+                    std::construct_at(std::addressof(m_error), other.m_error);
+                }
+            }
+
+            constexpr TaggedStorage(TaggedStorage&&) requires(TriviallyMoveConstructible) = default;
+            constexpr TaggedStorage(TaggedStorage&& other) noexcept(NothrowMoveConstructible)
+                requires(MoveConstructible && !TriviallyMoveConstructible)
+                : m_has_value(other.m_has_value) {
+                if (m_has_value) {
+                    std::construct_at(std::addressof(m_ok), std::move(other.m_ok));
+                } else {
+                    std::construct_at(std::addressof(m_error), std::move(other.m_error));
+                }
+            }
+
+            constexpr TaggedStorage& operator=(const TaggedStorage&) requires(TriviallyCopyAssignable) = default;
+            constexpr TaggedStorage& operator=(const TaggedStorage& other) noexcept(
+                NothrowCopyConstructible && std::is_nothrow_copy_assignable_v<OkType> &&
+                std::is_nothrow_copy_assignable_v<ErrorType>)
+                requires(CopyConstructible && !TriviallyCopyAssignable &&
+                         std::is_copy_assignable_v<OkType> && std::is_copy_assignable_v<ErrorType>) {
+                if (m_has_value && other.m_has_value) {
+                    m_ok = other.m_ok;
+                } else if (!m_has_value && !other.m_has_value) {
+                    m_error = other.m_error;
+                } else if (other.m_has_value) {
+                    emplace<OkIndex>(other.m_ok);
+                } else {
+                    emplace<ErrorIndex>(other.m_error);
+                }
+                return *this;
+            }
+
+            constexpr TaggedStorage& operator=(TaggedStorage&&) requires(TriviallyMoveAssignable) = default;
+            constexpr TaggedStorage& operator=(TaggedStorage&& other) noexcept(
+                NothrowMoveConstructible && std::is_nothrow_move_assignable_v<OkType> &&
+                std::is_nothrow_move_assignable_v<ErrorType>)
+                requires(MoveConstructible && !TriviallyMoveAssignable &&
+                         std::is_move_assignable_v<OkType> && std::is_move_assignable_v<ErrorType>) {
+                if (m_has_value && other.m_has_value) {
+                    m_ok = std::move(other.m_ok);
+                } else if (!m_has_value && !other.m_has_value) {
+                    m_error = std::move(other.m_error);
+                } else if (other.m_has_value) {
+                    emplace<OkIndex>(std::move(other.m_ok));
+                } else {
+                    emplace<ErrorIndex>(std::move(other.m_error));
+                }
+                return *this;
+            }
+
+            constexpr ~TaggedStorage() requires(TriviallyDestructible) = default;
+            constexpr ~TaggedStorage() { destroy(); }
+
+            [[nodiscard]] constexpr bool has_value() const noexcept { return m_has_value; }
+
+            [[nodiscard]] constexpr OkType& ok() noexcept { return m_ok; }
+            [[nodiscard]] constexpr const OkType& ok() const noexcept { return m_ok; }
+            [[nodiscard]] constexpr ErrorType& error() noexcept { return m_error; }
+            [[nodiscard]] constexpr const ErrorType& error() const noexcept { return m_error; }
+
+            // Replaces the current payload with a newly constructed alternative. If construction throws,
+            // the previous payload is kept or restored so the storage always holds a value; which payload
+            // is moved aside to make that possible is decided at compile time.
+            template <std::size_t Index, typename... Args>
+            constexpr std::conditional_t<Index == OkIndex, OkType, ErrorType>& emplace(Args&&... args) noexcept(
+                std::is_nothrow_constructible_v<std::conditional_t<Index == OkIndex, OkType, ErrorType>, Args...>) {
+                using NewType = std::conditional_t<Index == OkIndex, OkType, ErrorType>;
+
+                if constexpr (std::is_nothrow_constructible_v<NewType, Args...>) {
+                    destroy();
+                    construct<Index>(std::forward<Args>(args)...);
+                } else if constexpr (std::is_nothrow_move_constructible_v<NewType>) {
+                    NewType tmp(std::forward<Args>(args)...);
+                    destroy();
+                    construct<Index>(std::move(tmp));
+                } else if (m_has_value == (Index == OkIndex)) {
+                    // Same alternative: build the replacement first and assign it, so an exception
+                    // leaves the current payload in place.
+                    static_assert(std::is_move_assignable_v<NewType>,
+                                  "Result requires a payload that cannot be constructed or moved without throwing to be move assignable");
+                    get<Index>() = NewType(std::forward<Args>(args)...);
+                } else {
+                    reinit_guarded<Index>(get<Index == OkIndex ? ErrorIndex : OkIndex>(), std::forward<Args>(args)...);
+                }
+                return get<Index>();
+            }
+
+        private:
+            template <std::size_t Index>
+            constexpr auto& get() noexcept {
+                if constexpr (Index == OkIndex) {
+                    return m_ok;
+                } else {
+                    return m_error;
+                }
+            }
+
+            template <std::size_t Index, typename... Args>
+            constexpr void construct(Args&&... args) {
+                if constexpr (Index == OkIndex) {
+                    std::construct_at(std::addressof(m_ok), std::forward<Args>(args)...);
+                    m_has_value = true;
+                } else {
+                    std::construct_at(std::addressof(m_error), std::forward<Args>(args)...);
+                    m_has_value = false;
+                }
+            }
+
+            template <std::size_t Index, typename OldType, typename... Args>
+            constexpr void reinit_guarded([[maybe_unused]] OldType& old, Args&&... args) {
+#ifdef RESULT_NO_EXCEPTIONS
+                destroy();
+                construct<Index>(std::forward<Args>(args)...);
+#else
+                static_assert(std::is_nothrow_move_constructible_v<OldType>,
+                              "Result requires one of its payloads to be nothrow move constructible to replace the other");
+                OldType tmp(std::move(old));
+                destroy();
+                try {
+                    construct<Index>(std::forward<Args>(args)...);
+                } catch (...) {
+                    construct<Index == OkIndex ? ErrorIndex : OkIndex>(std::move(tmp));
+                    throw;
+                }
+#endif
+            }
+
+            constexpr void destroy() noexcept {
+                if (m_has_value) {
+                    std::destroy_at(std::addressof(m_ok));
+                } else {
+                    std::destroy_at(std::addressof(m_error));
+                }
+            }
+
+            union {
+                OkType m_ok;
+                ErrorType m_error;
+            };
+            bool m_has_value;
+        };
+
+        template <typename T>
+        constexpr inline bool IsResult = false;
+
+        template <typename OkType, typename ErrorType>
+        constexpr inline bool IsResult<Result<OkType, ErrorType>> = true;
+
+        template <typename T>
+        concept EmptyPayload = std::is_empty_v<T> && std::is_trivially_copyable_v<T> && std::semiregular<T>;
+
+        // Storage for a pair where one alternative is an empty type and the other has a niche: only
+        // the non-empty payload is kept, and holding its niche value means the empty alternative is
+        // active.
+        template <typename OkType, typename ErrorType, std::size_t PayloadIndex>
+        class NicheStorage {
+            using Payload = std::conditional_t<PayloadIndex == OkIndex, OkType, ErrorType>;
+            using Empty = std::conditional_t<PayloadIndex == OkIndex, ErrorType, OkType>;
+            constexpr static inline std::size_t EmptyIndex = PayloadIndex == OkIndex ? ErrorIndex : OkIndex;
+
+        public:
+            template <typename... Args>
+            constexpr explicit NicheStorage(std::in_place_index_t<PayloadIndex>, Args&&... args) noexcept(
+                std::is_nothrow_constructible_v<Payload, Args...>)
+                : m_payload(std::forward<Args>(args)...) {}
+
+            template <typename... Args>
+            constexpr explicit NicheStorage(std::in_place_index_t<EmptyIndex>, Args&&... args) noexcept(
+                std::is_nothrow_constructible_v<Empty, Args...>)
+                : m_payload(NicheTraits<Payload>::niche()), m_empty(std::forward<Args>(args)...) {}
+
+            template <typename F, typename... Args>
+            constexpr explicit NicheStorage(InPlaceInvoke<PayloadIndex>, F&& f, Args&&... args) noexcept(
+                std::is_nothrow_invocable_r_v<Payload, F, Args...>)
+                : m_payload(std::invoke(std::forward<F>(f), std::forward<Args>(args)...)) {}
+
+            template <typename F, typename... Args>
+            constexpr explicit NicheStorage(InPlaceInvoke<EmptyIndex>, F&& f, Args&&... args) noexcept(
+                std::is_nothrow_invocable_r_v<Empty, F, Args...>)
+                : m_payload(NicheTraits<Payload>::niche()),
+                  m_empty(std::invoke(std::forward<F>(f), std::forward<Args>(args)...)) {}
+
+            [[nodiscard]] constexpr bool has_value() const noexcept {
+                return NicheTraits<Payload>::is_niche(m_payload) == (PayloadIndex == ErrorIndex);
+            }
+
+            [[nodiscard]] constexpr OkType& ok() noexcept { return get<OkIndex>(*this); }
+            [[nodiscard]] constexpr const OkType& ok() const noexcept { return get<OkIndex>(*this); }
+            [[nodiscard]] constexpr ErrorType& error() noexcept { return get<ErrorIndex>(*this); }
+            [[nodiscard]] constexpr const ErrorType& error() const noexcept { return get<ErrorIndex>(*this); }
+
+            template <std::size_t Index, typename... Args>
+            constexpr auto& emplace(Args&&... args) noexcept(
+                std::is_nothrow_constructible_v<std::conditional_t<Index == PayloadIndex, Payload, Empty>, Args...> &&
+                std::is_nothrow_move_assignable_v<Payload>) {
+                if constexpr (Index == PayloadIndex) {
+                    m_payload = Payload(std::forward<Args>(args)...);
+                } else {
+                    m_empty = Empty(std::forward<Args>(args)...);
+                    m_payload = NicheTraits<Payload>::niche();
+                }
+                return get<Index>(*this);
+            }
+
+        private:
+            template <std::size_t Index, typename Self>
+            constexpr static auto& get(Self& self) noexcept {
+                if constexpr (Index == PayloadIndex) {
+                    return self.m_payload;
+                } else {
+                    return self.m_empty;
+                }
+            }
+
+            Payload m_payload;
+            [[no_unique_address]] Empty m_empty;
+        };
+
+        // Pointers to a PointerNiche type have a low bit of zero, which leaves room for an enum error
+        // of up to half a pointer in the same word.
+        template <typename OkType, typename ErrorType>
+        concept PointerNichePair =
+            std::is_pointer_v<OkType> && PointerNiche<std::remove_cv_t<std::remove_pointer_t<OkType>>>::value &&
+            std::is_enum_v<ErrorType> && sizeof(ErrorType) <= sizeof(OkType) / 2 &&
+            (std::endian::native == std::endian::little || std::endian::native == std::endian::big);
+
+        // Storage for a PointerNichePair: an error overlays the pointer with the byte holding the low
+        // bit of the address set to one, and its value in the other half of the word. Testing for the
+        // error reads that byte, so unlike the other storages it cannot be inspected during constant
+        // evaluation.
+        template <typename OkType, typename ErrorType>
+        class PointerNicheStorage {
+            constexpr static inline std::size_t Half = sizeof(OkType) / 2;
+            constexpr static inline std::size_t MarkByte = std::endian::native == std::endian::little ? 0 : sizeof(OkType) - 1;
+
+            struct LowMarkedError {
+                unsigned char mark = 1;
+                alignas(Half) ErrorType value;
+            };
+
+            struct HighMarkedError {
+                alignas(Half) ErrorType value;
+                alignas(Half) unsigned char padding[Half - 1] {};
+                unsigned char mark = 1;
+            };
+
+            using ErrorWord = std::conditional_t<MarkByte == 0, LowMarkedError, HighMarkedError>;
+            static_assert(sizeof(ErrorWord) == sizeof(OkType) && offsetof(ErrorWord, mark) == MarkByte);
+
+        public:
+            template <typename... Args>
+            constexpr explicit PointerNicheStorage(std::in_place_index_t<OkIndex>, Args&&... args) noexcept(
+                std::is_nothrow_constructible_v<OkType, Args...>)
+                : m_ok(std::forward<Args>(args)...) {
+                check_aligned();
+            }
+
+            template <typename... Args>
+            constexpr explicit PointerNicheStorage(std::in_place_index_t<ErrorIndex>, Args&&... args) noexcept(
+                std::is_nothrow_constructible_v<ErrorType, Args...>)
+                : m_error(word(ErrorType(std::forward<Args>(args)...))) {}
+
+            template <typename F, typename... Args>
+            constexpr explicit PointerNicheStorage(InPlaceInvoke<OkIndex>, F&& f, Args&&... args) noexcept(
+                std::is_nothrow_invocable_r_v<OkType, F, Args...>)
+                : m_ok(std::invoke(std::forward<F>(f), std::forward<Args>(args)...)) {
+                check_aligned();
+            }
+
+            template <typename F, typename... Args>
+            constexpr explicit PointerNicheStorage(InPlaceInvoke<ErrorIndex>, F&& f, Args&&... args) noexcept(
+                std::is_nothrow_invocable_r_v<ErrorType, F, Args...>)
+                : m_error(word(std::invoke(std::forward<F>(f), std::forward<Args>(args)...))) {}
+
+            [[nodiscard]] bool has_value() const noexcept {
+                return (reinterpret_cast<const unsigned char*>(this)[MarkByte] & 1) == 0;
+            }
+
+            [[nodiscard]] constexpr OkType& ok() noexcept { return m_ok; }
+            [[nodiscard]] constexpr const OkType& ok() const noexcept { return m_ok; }
+            [[nodiscard]] constexpr ErrorType& error() noexcept { return m_error.value; }
+            [[nodiscard]] constexpr const ErrorType& error() const noexcept { return m_error.value; }
+
+            // The new payload is built before the word is overwritten, as args may refer to the old one.
+            template <std::size_t Index, typename... Args>
+            constexpr auto& emplace(Args&&... args) noexcept(
+                std::is_nothrow_constructible_v<std::conditional_t<Index == OkIndex, OkType, ErrorType>, Args...>) {
+                if constexpr (Index == OkIndex) {
+                    OkType pointer(std::forward<Args>(args)...);
+                    std::construct_at(&m_ok, pointer);
+                    check_aligned();
+                    return m_ok;
+                } else {
+                    std::construct_at(&m_error, word(ErrorType(std::forward<Args>(args)...)));
+                    return m_error.value;
+                }
+            }
+
+        private:
+            constexpr void check_aligned() const noexcept {
+                if (!std::is_constant_evaluated()) {
+                    assert(has_value() && "Result holds a pointer that is not aligned to its pointee");
+                }
+            }
+
+            constexpr static ErrorWord word(ErrorType value) noexcept {
+                ErrorWord error;
+                error.value = value;
+                return error;
+            }
+
+            union {
+                OkType m_ok;
+                ErrorWord m_error;
+            };
+        };
+
+#ifdef RESULT_BOX_ERRORS_LARGER_THAN
+        constexpr inline std::size_t BoxThreshold = RESULT_BOX_ERRORS_LARGER_THAN;
+#else
+        constexpr inline std::size_t BoxThreshold = static_cast<std::size_t>(-1);
+#endif
+
+        template <typename OkType, typename ErrorType>
+        concept BoxedError =
+            BoxError<ErrorType>::value || (sizeof(ErrorType) > BoxThreshold && sizeof(ErrorType) > sizeof(OkType));
+
+        // Thread-local free list of Size-byte blocks. Blocks freed on a thread are reused by the next
+        // allocations on that thread, up to Capacity of them; the rest go back to operator delete.
+        template <std::size_t Size, std::size_t Align>
+        class BoxPool {
+        public:
+            constexpr static inline std::size_t Capacity = 64;
+
+            [[nodiscard]] static void* allocate() {
+                FreeList& list = t_free_list;
+                if (list.head != nullptr) {
+                    Block* block = list.head;
+                    list.head = block->next;
+                    --list.size;
+                    return block;
+                }
+                if constexpr (Align > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+                    return ::operator new(Size, std::align_val_t {Align});
+                } else {
+                    return ::operator new(Size);
+                }
+            }
+
+            static void deallocate(void* pointer) noexcept {
+                FreeList& list = t_free_list;
+                if (list.size < Capacity) {
+                    if (list.size == 0) {
+                        t_drain.armed = true;
+                    }
+                    list.head = ::new (pointer) Block {list.head};
+                    ++list.size;
+                } else {
+                    release(pointer);
+                }
+            }
+
+        private:
+            struct Block {
+                Block* next;
+            };
+
+            // Trivially destructible, so it stays usable while other thread-local and static objects
+            // are destroyed.
+            struct FreeList {
+                Block* head;
+                std::size_t size;
+            };
+
+            // Returns the cached blocks when the thread exits, and stops caching from then on.
+            struct Drain {
+                bool armed = false;
+
+                ~Drain() {
+                    FreeList& list = t_free_list;
+                    while (list.head != nullptr) {
+                        release(std::exchange(list.head, list.head->next));
+                    }
+                    list.size = Capacity;
+                }
+            };
+
+            static void release(void* pointer) noexcept {
+                if constexpr (Align > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+                    ::operator delete(pointer, Size, std::align_val_t {Align});
+                } else {
+                    ::operator delete(pointer, Size);
+                }
+            }
+
+            static constinit inline thread_local FreeList t_free_list {nullptr, 0};
+            static inline thread_local Drain t_drain;
+        };
+
+        // Owning pointer to a pooled error. Copies allocate; moves transfer the block and leave the
+        // source empty.
+        template <typename ErrorType>
+        class Box {
+            using Pool = BoxPool<(sizeof(ErrorType) + 15) / 16 * 16,
+                                 (alignof(ErrorType) > alignof(void*) ? alignof(ErrorType) : alignof(void*))>;
+
+        public:
+            template <typename... Args>
+            constexpr explicit Box(std::in_place_t, Args&&... args) : m_value(make(std::forward<Args>(args)...)) {}
+
+            constexpr Box(const Box& other) requires(std::is_copy_constructible_v<ErrorType>)
+                : m_value(other.m_value != nullptr ? make(*other.m_value) : nullptr) {}
+
+            constexpr Box(Box&& other) noexcept : m_value(std::exchange(other.m_value, nullptr)) {}
+
+            constexpr Box& operator=(const Box& other)
+                requires(std::is_copy_constructible_v<ErrorType> && std::is_copy_assignable_v<ErrorType>) {
+                if (m_value != nullptr && other.m_value != nullptr) {
+                    *m_value = *other.m_value;
+                } else if (this != &other) {
+                    ErrorType* value = other.m_value != nullptr ? make(*other.m_value) : nullptr;
+                    reset();
+                    m_value = value;
+                }
+                return *this;
+            }
+
+            constexpr Box& operator=(Box&& other) noexcept {
+                if (this != &other) {
+                    reset();
+                    m_value = std::exchange(other.m_value, nullptr);
+                }
+                return *this;
+            }
+
+            constexpr ~Box() { reset(); }
+
+            [[nodiscard]] constexpr ErrorType& get() const noexcept {
+                assert(m_value != nullptr && "error accessed on a moved-from Result");
+                return *m_value;
+            }
+
+            // Whether a move has taken the error.
+            [[nodiscard]] constexpr bool empty() const noexcept { return m_value == nullptr; }
+
+        private:
+            template <typename... Args>
+            constexpr static ErrorType* make(Args&&... args) {
+                ErrorType* value = allocate();
+#ifdef RESULT_NO_EXCEPTIONS
+                std::construct_at(value, std::forward<Args>(args)...);
+#else
+                try {
+                    std::construct_at(value, std::forward<Args>(args)...);
+                } catch (...) {
+                    deallocate(value);
+                    throw;
+                }
+#endif
+                return value;
+            }
+
+            constexpr static ErrorType* allocate() {
+                if (std::is_constant_evaluated()) {
+                    return std::allocator<ErrorType> {}.allocate(1);
+                }
+                return static_cast<ErrorType*>(Pool::allocate());
+            }
+
+            constexpr static void deallocate(ErrorType* value) noexcept {
+                if (std::is_constant_evaluated()) {
+                    std::allocator<ErrorType> {}.deallocate(value, 1);
+                } else {
+                    Pool::deallocate(value);
+                }
+            }
+
+            constexpr void reset() noexcept {
+                if (m_value != nullptr) {
+                    std::destroy_at(m_value);
+                    deallocate(std::exchange(m_value, nullptr));
+                }
+            }
+
+            ErrorType* m_value;
+        };
+
+        // Tagged storage that keeps the error in a Box, so that it costs one pointer on the Ok path.
+        template <typename OkType, typename ErrorType>
+        class BoxedStorage {
+        public:
+            template <typename... Args>
+            constexpr explicit BoxedStorage(std::in_place_index_t<OkIndex> tag, Args&&... args) noexcept(
+                std::is_nothrow_constructible_v<OkType, Args...>)
+                : m_storage(tag, std::forward<Args>(args)...) {}
+
+            template <typename... Args>
+            constexpr explicit BoxedStorage(std::in_place_index_t<ErrorIndex> tag, Args&&... args)
+                : m_storage(tag, std::in_place, std::forward<Args>(args)...) {}
+
+            template <typename F, typename... Args>
+            constexpr explicit BoxedStorage(InPlaceInvoke<OkIndex> tag, F&& f, Args&&... args) noexcept(
+                std::is_nothrow_invocable_r_v<OkType, F, Args...>)
+                : m_storage(tag, std::forward<F>(f), std::forward<Args>(args)...) {}
+
+            template <typename F, typename... Args>
+            constexpr explicit BoxedStorage(InPlaceInvoke<ErrorIndex>, F&& f, Args&&... args)
+                : m_storage(std::in_place_index<ErrorIndex>, std::in_place,
+                            std::invoke(std::forward<F>(f), std::forward<Args>(args)...)) {}
+
+            [[nodiscard]] constexpr bool has_value() const noexcept { return m_storage.has_value(); }
+
+            [[nodiscard]] constexpr OkType& ok() noexcept { return m_storage.ok(); }
+            [[nodiscard]] constexpr const OkType& ok() const noexcept { return m_storage.ok(); }
+            [[nodiscard]] constexpr ErrorType& error() noexcept { return m_storage.error().get(); }
+            [[nodiscard]] constexpr const ErrorType& error() const noexcept { return m_storage.error().get(); }
+
+            // Errors are allocated, so only the Ok alternative can be emplaced without throwing.
+            template <std::size_t Index, typename... Args>
+            constexpr auto& emplace(Args&&... args) noexcept(Index == OkIndex &&
+                                                             std::is_nothrow_constructible_v<OkType, Args...>) {
+                if constexpr (Index == OkIndex) {
+                    return m_storage.template emplace<OkIndex>(std::forward<Args>(args)...);
+                } else {
+                    return m_storage.template emplace<ErrorIndex>(std::in_place, std::forward<Args>(args)...).get();
+                }
+            }
+
+            // Replaces the current error, reusing its block unless a move has taken it.
+            constexpr void assign_error(ErrorType&& value) {
+                Box<ErrorType>& box = m_storage.error();
+                if (box.empty()) {
+                    box = Box<ErrorType>(std::in_place, std::move(value));
+                } else {
+                    box.get() = std::move(value);
+                }
+            }
+
+        private:
+            TaggedStorage<OkType, Box<ErrorType>> m_storage;
+        };
+
+        // Assigns to the error of storage that holds one.
+        template <typename Storage, typename Value>
+        constexpr void assign_error(Storage& storage, Value&& value) {
+            storage.error() = std::forward<Value>(value);
+        }
+
+        template <typename OkType, typename ErrorType>
+        constexpr void assign_error(BoxedStorage<OkType, ErrorType>& storage, ErrorType&& value) {
+            storage.assign_error(std::move(value));
+        }
+
+        // Chooses the storage of a Result. Headers that define an error type with a layout of its own
+        // to exploit (such as AnyError) specialize it for that type.
+        template <typename OkType, typename ErrorType>
+        struct StorageFor {
+            using type = std::conditional_t<
+                BoxedError<OkType, ErrorType>, BoxedStorage<OkType, ErrorType>,
+                std::conditional_t<
+                    EmptyPayload<OkType> && HasNiche<ErrorType>, NicheStorage<OkType, ErrorType, ErrorIndex>,
+                    std::conditional_t<
+                        EmptyPayload<ErrorType> && HasNiche<OkType>, NicheStorage<OkType, ErrorType, OkIndex>,
+                        std::conditional_t<PointerNichePair<OkType, ErrorType>, PointerNicheStorage<OkType, ErrorType>,
+                                           TaggedStorage<OkType, ErrorType>>>>>;
+        };
+
+        template <typename OkType, typename ErrorType>
+        using Storage = typename StorageFor<OkType, ErrorType>::type;
+
+        template <typename R>
+        using StorageOf = Storage<std::conditional_t<std::is_void_v<typename R::value_type>, Unit, typename R::value_type>,
+                                  typename R::error_type>;
+
+        // Type of a payload of type T accessed through a Result of type Self.
+        template <typename Self, typename T>
+        using ForwardLike = decltype(forward_like<Self>(std::declval<T&>()));
+
+        // Results of the callables passed to and_then()/or_else() and to transform()/transform_error().
+        template <typename F, typename... Args>
+        using Chained = std::remove_cvref_t<std::invoke_result_t<F, Args...>>;
+
+        template <typename F, typename... Args>
+        using Transformed = std::remove_cv_t<std::invoke_result_t<F, Args...>>;
+
+        // Whether map() and map_error() can invoke F with Args, wrap the result in a temporary Wrapper (Ok
+        // or Error) and construct R from it without throwing.
+        template <typename R, template <typename> typename Wrapper, typename F, typename... Args>
+        consteval bool nothrow_wrap_invoke() {
+            using T = std::invoke_result_t<F, Args...>;
+            if constexpr (std::is_void_v<T>) {
+                return std::is_nothrow_invocable_v<F, Args...> && std::is_nothrow_constructible_v<R, Wrapper<void>>;
+            } else {
+                return std::is_nothrow_invocable_v<F, Args...> && std::is_nothrow_constructible_v<Wrapper<T>, T> &&
+                       std::is_nothrow_constructible_v<R, Wrapper<T>>;
+            }
+        }
+
+        // Whether transform() and transform_error() can materialize the result of invoking F with Args as
+        // alternative Index of R without throwing.
+        template <typename R, std::size_t Index, typename F, typename... Args>
+        consteval bool nothrow_invoke_into() {
+            if constexpr (std::is_void_v<std::invoke_result_t<F, Args...>>) {
+                return std::is_nothrow_invocable_v<F, Args...> && std::is_nothrow_constructible_v<R, InPlaceOkTag>;
+            } else {
+                return std::is_nothrow_constructible_v<StorageOf<R>, InPlaceInvoke<Index>, F, Args...>;
+            }
+        }
+    }
 
     template <typename OkType, typename ErrorType>
     class Result {
     public:
-        constexpr Result(Ok<OkType> v) : m_value(std::in_place_index<OkIndex>, std::move(v.value)) {}
-        constexpr Result(Error<ErrorType> v) : m_value(std::in_place_index<ErrorIndex>, std::move(v.value)) {}
+        using value_type = OkType;
+        using error_type = ErrorType;
+
+        constexpr Result(Ok<OkType> v) noexcept(NothrowStore<detail::OkIndex, OkType>) : m_storage(std::in_place_index<detail::OkIndex>, std::move(v.value)) {}
+        constexpr Result(Error<ErrorType> v) noexcept(NothrowStore<detail::ErrorIndex, ErrorType>) : m_storage(std::in_place_index<detail::ErrorIndex>, std::move(v.value)) {}
+
+        template <typename... Args>
+        requires(std::is_constructible_v<OkType, Args...>)
+        constexpr explicit Result(InPlaceOkTag, Args&&... args) noexcept(NothrowStore<detail::OkIndex, Args...>)
+            : m_storage(std::in_place_index<detail::OkIndex>, std::forward<Args>(args)...) {}
+
+        template <typename... Args>
+        requires(std::is_constructible_v<ErrorType, Args...>)
+        constexpr explicit Result(InPlaceErrorTag, Args&&... args) noexcept(NothrowStore<detail::ErrorIndex, Args...>)
+            : m_storage(std::in_place_index<detail::ErrorIndex>, std::forward<Args>(args)...) {}
 
-        constexpr Result& operator=(Ok<OkType> v) {
-            m_value = std::variant<OkType, ErrorType> {std::in_place_index<OkIndex>, std::move(v.value)};
+        constexpr Result& operator=(Ok<OkType> v) noexcept(
+            std::is_nothrow_move_assignable_v<OkType> && NothrowEmplace<detail::OkIndex, OkType>) {
+            if (m_storage.has_value()) {
+                m_storage.ok() = std::move(v.value);
+            } else {
+                m_storage.template emplace<detail::OkIndex>(std::move(v.value));
+            }
             return *this;
         }
 
-        constexpr Result& operator=(Error<ErrorType> v) {
-            m_value = std::variant<OkType, ErrorType> {std::in_place_index<ErrorIndex>, std::move(v.value)};
+        constexpr Result& operator=(Error<ErrorType> v) noexcept(
+            std::is_nothrow_move_assignable_v<ErrorType> && NothrowEmplace<detail::ErrorIndex, ErrorType>) {
+            if (m_storage.has_value()) {
+                m_storage.template emplace<detail::ErrorIndex>(std::move(v.value));
+            } else {
+                detail::assign_error(m_storage, std::move(v.value));
+            }
             return *this;
         }
 
-        [[nodiscard]] constexpr const OkType& unwrap() const& {
-            if (const ErrorType* error_ptr = std::get_if<ErrorIndex>(&m_value)) {
-                throw BadUnwrapException<ErrorType>(*error_ptr);
-            }
-            const OkType* ok_ptr = std::get_if<OkIndex>(&m_value);
-            return *ok_ptr;
+        template <typename... Args>
+        requires(std::is_constructible_v<OkType, Args...>)
+        constexpr OkType& emplace_ok(Args&&... args) noexcept(NothrowEmplace<detail::OkIndex, Args...>) {
+            return m_storage.template emplace<detail::OkIndex>(std::forward<Args>(args)...);
         }
 
-        [[nodiscard]] constexpr OkType&& unwrap() && {
-            if (ErrorType* error_ptr = std::get_if<ErrorIndex>(&m_value)) {
-                throw BadUnwrapException<ErrorType>(std::move(*error_ptr));
-            }
-            OkType* ok_ptr = std::get_if<OkIndex>(&m_value);
-            return std::move(*ok_ptr);
+        template <typename... Args>
+        requires(std::is_constructible_v<ErrorType, Args...>)
+        constexpr ErrorType& emplace_error(Args&&... args) noexcept(NothrowEmplace<detail::ErrorIndex, Args...>) {
+            return m_storage.template emplace<detail::ErrorIndex>(std::forward<Args>(args)...);
         }
 
-        [[nodiscard]] constexpr const ErrorType& error() const& {
-            if (const OkType* ok_ptr = std::get_if<OkIndex>(&m_value)) {
-                throw std::runtime_error("Failed to access error of a successful Result");
-            }
-            const ErrorType* error_ptr = std::get_if<ErrorIndex>(&m_value);
-            return *error_ptr;
+        [[nodiscard]] constexpr OkType& unwrap(RESULT_LOCATION) & {
+            return unwrap_impl(*this RESULT_AND_LOCATION_ARG);
+        }
+        [[nodiscard]] constexpr const OkType& unwrap(RESULT_LOCATION) const& {
+            return unwrap_impl(*this RESULT_AND_LOCATION_ARG);
+        }
+        [[nodiscard]] constexpr OkType&& unwrap(RESULT_LOCATION) && {
+            return unwrap_impl(std::move(*this) RESULT_AND_LOCATION_ARG);
+        }
+        [[nodiscard]] constexpr const OkType&& unwrap(RESULT_LOCATION) const&& {
+            return unwrap_impl(std::move(*this) RESULT_AND_LOCATION_ARG);
         }
 
-        [[nodiscard]] constexpr ErrorType&& error() && {
-            if (const OkType* ok_ptr = std::get_if<OkIndex>(&m_value)) {
-                throw std::runtime_error("Failed to access error of a successful Result");
-            }
-            ErrorType* error_ptr = std::get_if<ErrorIndex>(&m_value);
-            return std::move(*error_ptr);
+        [[nodiscard]] constexpr ErrorType& error(RESULT_LOCATION) & {
+            return error_impl(*this RESULT_AND_LOCATION_ARG);
+        }
+        [[nodiscard]] constexpr const ErrorType& error(RESULT_LOCATION) const& {
+            return error_impl(*this RESULT_AND_LOCATION_ARG);
+        }
+        [[nodiscard]] constexpr ErrorType&& error(RESULT_LOCATION) && {
+            return error_impl(std::move(*this) RESULT_AND_LOCATION_ARG);
+        }
+        [[nodiscard]] constexpr const ErrorType&& error(RESULT_LOCATION) const&& {
+            return error_impl(std::move(*this) RESULT_AND_LOCATION_ARG);
         }
 
-        [[nodiscard]] constexpr bool has_value() const noexcept { return std::get_if<OkIndex>(&m_value); }
-        [[nodiscard]] constexpr bool has_error() const noexcept { return std::get_if<ErrorIndex>(&m_value); }
+        [[nodiscard]] constexpr bool has_value() const noexcept { return m_storage.has_value(); }
+        [[nodiscard]] constexpr bool has_error() const noexcept { return !m_storage.has_value(); }
         constexpr operator bool() const noexcept { return has_value(); }
 
-        template <typename F, typename NewOkType = std::invoke_result_t<F, const OkType&>>
-        [[nodiscard]] constexpr auto map(F f) const & noexcept(std::is_nothrow_invocable_v<F, const OkType&>)
-        -> Result<NewOkType, ErrorType> {
-            if (has_error()) {
-                return Error{error()};
+        // Unchecked accessors for code that has already tested the Result. Misuse is caught by an
+        // assertion in debug builds and is undefined behavior otherwise.
+        [[nodiscard]] constexpr const OkType& unwrap_unchecked() const& noexcept {
+            assert(m_storage.has_value() && "unwrap_unchecked() called on an error Result");
+            return m_storage.ok();
+        }
+
+        [[nodiscard]] constexpr OkType& unwrap_unchecked() & noexcept {
+            assert(m_storage.has_value() && "unwrap_unchecked() called on an error Result");
+            return m_storage.ok();
+        }
+
+        [[nodiscard]] constexpr OkType&& unwrap_unchecked() && noexcept {
+            assert(m_storage.has_value() && "unwrap_unchecked() called on an error Result");
+            return std::move(m_storage.ok());
+        }
+
+        [[nodiscard]] constexpr const ErrorType& error_unchecked() const& noexcept {
+            assert(!m_storage.has_value() && "error_unchecked() called on a successful Result");
+            return m_storage.error();
+        }
+
+        [[nodiscard]] constexpr ErrorType& error_unchecked() & noexcept {
+            assert(!m_storage.has_value() && "error_unchecked() called on a successful Result");
+            return m_storage.error();
+        }
+
+        [[nodiscard]] constexpr ErrorType&& error_unchecked() && noexcept {
+            assert(!m_storage.has_value() && "error_unchecked() called on a successful Result");
+            return std::move(m_storage.error());
+        }
+
+        [[nodiscard]] constexpr const OkType& operator*() const& noexcept { return unwrap_unchecked(); }
+        [[nodiscard]] constexpr OkType& operator*() & noexcept { return unwrap_unchecked(); }
+        [[nodiscard]] constexpr OkType&& operator*() && noexcept { return std::move(*this).unwrap_unchecked(); }
+
+        [[nodiscard]] constexpr const OkType* operator->() const noexcept { return std::addressof(unwrap_unchecked()); }
+        [[nodiscard]] constexpr OkType* operator->() noexcept { return std::addressof(unwrap_unchecked()); }
+
+        // f is forwarded and receives the payload with the value category of *this.
+        template <typename F>
+        [[nodiscard]] constexpr auto map(F&& f) & noexcept(noexcept(map_impl(*this, std::forward<F>(f)))) {
+            return map_impl(*this, std::forward<F>(f));
+        }
+        template <typename F>
+        [[nodiscard]] constexpr auto map(F&& f) const& noexcept(noexcept(map_impl(*this, std::forward<F>(f)))) {
+            return map_impl(*this, std::forward<F>(f));
+        }
+        template <typename F>
+        [[nodiscard]] constexpr auto map(F&& f) && noexcept(noexcept(map_impl(std::move(*this), std::forward<F>(f)))) {
+            return map_impl(std::move(*this), std::forward<F>(f));
+        }
+        template <typename F>
+        [[nodiscard]] constexpr auto map(F&& f) const&& noexcept(noexcept(map_impl(std::move(*this), std::forward<F>(f)))) {
+            return map_impl(std::move(*this), std::forward<F>(f));
+        }
+
+        template <typename F>
+        [[nodiscard]] constexpr auto map_error(F&& f RESULT_AND_LOCATION) & noexcept(
+            noexcept(map_error_impl(*this, std::forward<F>(f) RESULT_AND_LOCATION_ARG))) {
+            return map_error_impl(*this, std::forward<F>(f) RESULT_AND_LOCATION_ARG);
+        }
+        template <typename F>
+        [[nodiscard]] constexpr auto map_error(F&& f RESULT_AND_LOCATION) const& noexcept(
+            noexcept(map_error_impl(*this, std::forward<F>(f) RESULT_AND_LOCATION_ARG))) {
+            return map_error_impl(*this, std::forward<F>(f) RESULT_AND_LOCATION_ARG);
+        }
+        template <typename F>
+        [[nodiscard]] constexpr auto map_error(F&& f RESULT_AND_LOCATION) && noexcept(
+            noexcept(map_error_impl(std::move(*this), std::forward<F>(f) RESULT_AND_LOCATION_ARG))) {
+            return map_error_impl(std::move(*this), std::forward<F>(f) RESULT_AND_LOCATION_ARG);
+        }
+        template <typename F>
+        [[nodiscard]] constexpr auto map_error(F&& f RESULT_AND_LOCATION) const&& noexcept(
+            noexcept(map_error_impl(std::move(*this), std::forward<F>(f) RESULT_AND_LOCATION_ARG))) {
+            return map_error_impl(std::move(*this), std::forward<F>(f) RESULT_AND_LOCATION_ARG);
+        }
+
+        // Monadic combinators. Each tests the tag once and forwards the payload with the value
+        // category of *this.
+        template <typename F>
+        constexpr auto and_then(F&& f) & noexcept(noexcept(and_then_impl(*this, std::forward<F>(f)))) {
+            return and_then_impl(*this, std::forward<F>(f));
+        }
+        template <typename F>
+        constexpr auto and_then(F&& f) const& noexcept(noexcept(and_then_impl(*this, std::forward<F>(f)))) {
+            return and_then_impl(*this, std::forward<F>(f));
+        }
+        template <typename F>
+        constexpr auto and_then(F&& f) && noexcept(noexcept(and_then_impl(std::move(*this), std::forward<F>(f)))) {
+            return and_then_impl(std::move(*this), std::forward<F>(f));
+        }
+        template <typename F>
+        constexpr auto and_then(F&& f) const&& noexcept(noexcept(and_then_impl(std::move(*this), std::forward<F>(f)))) {
+            return and_then_impl(std::move(*this), std::forward<F>(f));
+        }
+
+        template <typename F>
+        constexpr auto or_else(F&& f) & noexcept(noexcept(or_else_impl(*this, std::forward<F>(f)))) {
+            return or_else_impl(*this, std::forward<F>(f));
+        }
+        template <typename F>
+        constexpr auto or_else(F&& f) const& noexcept(noexcept(or_else_impl(*this, std::forward<F>(f)))) {
+            return or_else_impl(*this, std::forward<F>(f));
+        }
+        template <typename F>
+        constexpr auto or_else(F&& f) && noexcept(noexcept(or_else_impl(std::move(*this), std::forward<F>(f)))) {
+            return or_else_impl(std::move(*this), std::forward<F>(f));
+        }
+        template <typename F>
+        constexpr auto or_else(F&& f) const&& noexcept(noexcept(or_else_impl(std::move(*this), std::forward<F>(f)))) {
+            return or_else_impl(std::move(*this), std::forward<F>(f));
+        }
+
+        template <typename F>
+        constexpr auto transform(F&& f) & noexcept(noexcept(transform_impl(*this, std::forward<F>(f)))) {
+            return transform_impl(*this, std::forward<F>(f));
+        }
+        template <typename F>
+        constexpr auto transform(F&& f) const& noexcept(noexcept(transform_impl(*this, std::forward<F>(f)))) {
+            return transform_impl(*this, std::forward<F>(f));
+        }
+        template <typename F>
+        constexpr auto transform(F&& f) && noexcept(noexcept(transform_impl(std::move(*this), std::forward<F>(f)))) {
+            return transform_impl(std::move(*this), std::forward<F>(f));
+        }
+        template <typename F>
+        constexpr auto transform(F&& f) const&& noexcept(noexcept(transform_impl(std::move(*this), std::forward<F>(f)))) {
+            return transform_impl(std::move(*this), std::forward<F>(f));
+        }
+
+        template <typename F>
+        constexpr auto transform_error(F&& f) & noexcept(noexcept(transform_error_impl(*this, std::forward<F>(f)))) {
+            return transform_error_impl(*this, std::forward<F>(f));
+        }
+        template <typename F>
+        constexpr auto transform_error(F&& f) const& noexcept(noexcept(transform_error_impl(*this, std::forward<F>(f)))) {
+            return transform_error_impl(*this, std::forward<F>(f));
+        }
+        template <typename F>
+        constexpr auto transform_error(F&& f) && noexcept(noexcept(transform_error_impl(std::move(*this), std::forward<F>(f)))) {
+            return transform_error_impl(std::move(*this), std::forward<F>(f));
+        }
+        template <typename F>
+        constexpr auto transform_error(F&& f) const&& noexcept(noexcept(transform_error_impl(std::move(*this), std::forward<F>(f)))) {
+            return transform_error_impl(std::move(*this), std::forward<F>(f));
+        }
+
+        // Starts a deferred map/map_error chain; see Pipeline.
+        [[nodiscard]] constexpr auto lazy() & noexcept {
+            return Pipeline<Result&, detail::Identity, detail::Identity>(*this, {}, {});
+        }
+        [[nodiscard]] constexpr auto lazy() const& noexcept {
+            return Pipeline<const Result&, detail::Identity, detail::Identity>(*this, {}, {});
+        }
+        [[nodiscard]] constexpr auto lazy() && noexcept {
+            return Pipeline<Result&&, detail::Identity, detail::Identity>(std::move(*this), {}, {});
+        }
+
+    private:
+        template <typename, typename>
+        friend class Result;
+
+        template <typename, typename, typename>
+        friend class Pipeline;
+
+        using StorageType = detail::Storage<OkType, ErrorType>;
+
+        template <std::size_t Index, typename... Args>
+        constexpr static inline bool NothrowStore =
+            std::is_nothrow_constructible_v<StorageType, std::in_place_index_t<Index>, Args...>;
+
+        template <std::size_t Index, typename... Args>
+        constexpr static inline bool NothrowEmplace =
+            noexcept(std::declval<StorageType&>().template emplace<Index>(std::declval<Args>()...));
+
+        template <typename Self>
+        using OkRef = detail::ForwardLike<Self, OkType>;
+
+        template <typename Self>
+        using ErrorRef = detail::ForwardLike<Self, ErrorType>;
+
+        template <std::size_t Index, typename F, typename... Args>
+        constexpr Result(detail::InPlaceInvoke<Index> tag, F&& f, Args&&... args) noexcept(
+            std::is_nothrow_constructible_v<StorageType, detail::InPlaceInvoke<Index>, F, Args...>)
+            : m_storage(tag, std::forward<F>(f), std::forward<Args>(args)...) {}
+
+        template <typename Self>
+        constexpr static OkRef<Self> unwrap_impl(Self&& self RESULT_AND_LOCATION) {
+            if (!self.m_storage.has_value()) [[unlikely]] {
+                RESULT_STATS_COUNT(UnwrapFailed, ErrorType, location);
+                RESULT_PROBE(unwrap_failed, ErrorType, location);
+                detail::bad_unwrap<ErrorType>(detail::forward_like<Self>(self.m_storage.error()));
             }
-            if constexpr (std::is_same_v<NewOkType, void>) {
-                f(unwrap());
-                return Ok<void> {};
-            } else {
-                return Ok{f(unwrap())};
+            return detail::forward_like<Self>(self.m_storage.ok());
+        }
+
+        template <typename Self>
+        constexpr static ErrorRef<Self> error_impl(Self&& self RESULT_AND_LOCATION) {
+            if (self.m_storage.has_value()) [[unlikely]] {
+                RESULT_STATS_COUNT(BadErrorAccess, ErrorType, location);
+                detail::bad_error_access();
             }
+            return detail::forward_like<Self>(self.m_storage.error());
         }
 
-        template <typename F, typename NewOkType = std::invoke_result_t<F, OkType&&>>
-        [[nodiscard]] constexpr auto map(F f) && noexcept(std::is_nothrow_invocable_v<F, OkType&&>)
+        template <typename Self, typename F, typename NewOkType = std::invoke_result_t<F, OkRef<Self>>>
+        constexpr static auto map_impl(Self&& self, F&& f) noexcept(
+            std::is_nothrow_constructible_v<Result<NewOkType, ErrorType>, InPlaceErrorTag, ErrorRef<Self>> &&
+            detail::nothrow_wrap_invoke<Result<NewOkType, ErrorType>, Ok, F, OkRef<Self>>())
         -> Result<NewOkType, ErrorType> {
-            if (has_error()) {
-                return Error{std::move(*this).error()};
+            if (!self.m_storage.has_value()) {
+                return Result<NewOkType, ErrorType>(in_place_error, detail::forward_like<Self>(self.m_storage.error()));
             }
-            if constexpr (std::is_same_v<NewOkType, void>) {
-                f(f(std::move(*this).unwrap()));
+            if constexpr (std::is_void_v<NewOkType>) {
+                std::invoke(std::forward<F>(f), detail::forward_like<Self>(self.m_storage.ok()));
                 return Ok<void> {};
             } else {
-                return Ok{f(std::move(*this).unwrap())};
+                return Ok {std::invoke(std::forward<F>(f), detail::forward_like<Self>(self.m_storage.ok()))};
             }
         }
 
-        template <typename F, typename NewErrorType = std::invoke_result_t<F, const ErrorType&>>
-        [[nodiscard]] constexpr auto map_error(F f) const & noexcept(std::is_nothrow_invocable_v<F, const ErrorType&>)
+        template <typename Self, typename F, typename NewErrorType = std::invoke_result_t<F, ErrorRef<Self>>>
+        constexpr static auto map_error_impl(Self&& self, F&& f RESULT_AND_LOCATION) noexcept(
+            std::is_nothrow_constructible_v<Result<OkType, NewErrorType>, InPlaceOkTag, OkRef<Self>> &&
+            detail::nothrow_wrap_invoke<Result<OkType, NewErrorType>, Error, F, ErrorRef<Self>>())
         -> Result<OkType, NewErrorType> {
-            if (has_value()) {
-                return Ok{unwrap()};
+            if (self.m_storage.has_value()) {
+                return Result<OkType, NewErrorType>(in_place_ok, detail::forward_like<Self>(self.m_storage.ok()));
             }
-            return Error{f(error())};
+            RESULT_PROBE(map_error, ErrorType, location);
+            return Error<NewErrorType>(
+                std::invoke(std::forward<F>(f), detail::forward_like<Self>(self.m_storage.error())) RESULT_AND_LOCATION_ARG);
         }
 
-        template <typename F, typename NewErrorType = std::invoke_result_t<F, ErrorType>>
-        [[nodiscard]] constexpr auto map_error(F f) && noexcept(std::is_nothrow_invocable_v<F, ErrorType>)
-        -> Result<OkType, NewErrorType> {
-            if (has_value()) {
-                return Ok{std::move(*this).unwrap()};
+        template <typename Self, typename F, typename NewResult = detail::Chained<F, OkRef<Self>>>
+        constexpr static auto and_then_impl(Self&& self, F&& f) noexcept(
+            std::is_nothrow_invocable_r_v<NewResult, F, OkRef<Self>> &&
+            std::is_nothrow_constructible_v<NewResult, InPlaceErrorTag, ErrorRef<Self>>) {
+            static_assert(detail::IsResult<NewResult>, "and_then() callable must return a Result");
+            static_assert(std::is_same_v<typename NewResult::error_type, ErrorType>,
+                          "and_then() callable must return a Result with the same error type");
+
+            if (self.has_value()) {
+                return std::invoke(std::forward<F>(f), detail::forward_like<Self>(self.m_storage.ok()));
             }
-            return Error{f(std::move(*this).error())};
+            return NewResult(in_place_error, detail::forward_like<Self>(self.m_storage.error()));
         }
 
-    private:
-        constexpr static inline std::size_t OkIndex = 0;
-        constexpr static inline std::size_t ErrorIndex = 1;
+        template <typename Self, typename F, typename NewResult = detail::Chained<F, ErrorRef<Self>>>
+        constexpr static auto or_else_impl(Self&& self, F&& f) noexcept(
+            std::is_nothrow_invocable_r_v<NewResult, F, ErrorRef<Self>> &&
+            std::is_nothrow_constructible_v<NewResult, InPlaceOkTag, OkRef<Self>>) {
+            static_assert(detail::IsResult<NewResult>, "or_else() callable must return a Result");
+            static_assert(std::is_same_v<typename NewResult::value_type, OkType>,
+                          "or_else() callable must return a Result with the same value type");
+
+            if (self.has_value()) {
+                return NewResult(in_place_ok, detail::forward_like<Self>(self.m_storage.ok()));
+            }
+            return std::invoke(std::forward<F>(f), detail::forward_like<Self>(self.m_storage.error()));
+        }
+
+        template <typename Self, typename F, typename NewResult = Result<detail::Transformed<F, OkRef<Self>>, ErrorType>>
+        constexpr static auto transform_impl(Self&& self, F&& f) noexcept(
+            detail::nothrow_invoke_into<NewResult, detail::OkIndex, F, OkRef<Self>>() &&
+            std::is_nothrow_constructible_v<NewResult, InPlaceErrorTag, ErrorRef<Self>>) {
+            using NewOkType = typename NewResult::value_type;
+
+            if (self.has_value()) {
+                if constexpr (std::is_void_v<NewOkType>) {
+                    std::invoke(std::forward<F>(f), detail::forward_like<Self>(self.m_storage.ok()));
+                    return NewResult(in_place_ok);
+                } else {
+                    return NewResult(detail::InPlaceInvoke<detail::OkIndex> {}, std::forward<F>(f),
+                                     detail::forward_like<Self>(self.m_storage.ok()));
+                }
+            }
+            return NewResult(in_place_error, detail::forward_like<Self>(self.m_storage.error()));
+        }
+
+        template <typename Self, typename F, typename NewResult = Result<OkType, detail::Transformed<F, ErrorRef<Self>>>>
+        constexpr static auto transform_error_impl(Self&& self, F&& f) noexcept(
+            detail::nothrow_invoke_into<NewResult, detail::ErrorIndex, F, ErrorRef<Self>>() &&
+            std::is_nothrow_constructible_v<NewResult, InPlaceOkTag, OkRef<Self>>) {
 
-        std::variant<OkType, ErrorType> m_value;
+            if (self.has_value()) {
+                return NewResult(in_place_ok, detail::forward_like<Self>(self.m_storage.ok()));
+            }
+            return NewResult(detail::InPlaceInvoke<detail::ErrorIndex> {}, std::forward<F>(f),
+                             detail::forward_like<Self>(self.m_storage.error()));
+        }
+
+        StorageType m_storage;
     };
 
     template <typename ErrorType>
     class Result<void, ErrorType> {
     public:
-        constexpr Result(Ok<>) : m_error(std::nullopt) {}
-        constexpr Result(Error<ErrorType> v) : m_error(std::move(v.value)) {}
+        using value_type = void;
+        using error_type = ErrorType;
+
+        constexpr Result(Ok<>) noexcept(NothrowStore<detail::OkIndex>) : m_storage(std::in_place_index<detail::OkIndex>) {}
+        constexpr Result(Error<ErrorType> v) noexcept(NothrowStore<detail::ErrorIndex, ErrorType>) : m_storage(std::in_place_index<detail::ErrorIndex>, std::move(v.value)) {}
+
+        constexpr explicit Result(InPlaceOkTag) noexcept(NothrowStore<detail::OkIndex>) : m_storage(std::in_place_index<detail::OkIndex>) {}
+
+        template <typename... Args>
+        requires(std::is_constructible_v<ErrorType, Args...>)
+        constexpr explicit Result(InPlaceErrorTag, Args&&... args) noexcept(NothrowStore<detail::ErrorIndex, Args...>)
+            : m_storage(std::in_place_index<detail::ErrorIndex>, std::forward<Args>(args)...) {}
 
-        constexpr Result& operator=(Ok<>) {
-            m_error = std::nullopt;
+        constexpr Result& operator=(Ok<>) noexcept(NothrowEmplace<detail::OkIndex>) {
+            if (!m_storage.has_value()) {
+                m_storage.template emplace<detail::OkIndex>();
+            }
             return *this;
         }
 
-        constexpr Result& operator=(Error<ErrorType> v) {
-            m_error = std::move(v.value);
+        constexpr Result& operator=(Error<ErrorType> v) noexcept(
+            std::is_nothrow_move_assignable_v<ErrorType> && NothrowEmplace<detail::ErrorIndex, ErrorType>) {
+            if (m_storage.has_value()) {
+                m_storage.template emplace<detail::ErrorIndex>(std::move(v.value));
+            } else {
+                detail::assign_error(m_storage, std::move(v.value));
+            }
             return *this;
         }
 
-        constexpr void unwrap() const& {
-            if (m_error.has_value()) {
-                throw BadUnwrapException<ErrorType>(m_error.value());
+        constexpr void emplace_ok() noexcept(NothrowEmplace<detail::OkIndex>) {
+            if (!m_storage.has_value()) {
+                m_storage.template emplace<detail::OkIndex>();
             }
         }
 
-        constexpr void unwrap() && {
-            if (m_error.has_value()) {
-                throw BadUnwrapException<ErrorType>(std::move(m_error).value());
-            }
+        template <typename... Args>
+        requires(std::is_constructible_v<ErrorType, Args...>)
+        constexpr ErrorType& emplace_error(Args&&... args) noexcept(NothrowEmplace<detail::ErrorIndex, Args...>) {
+            return m_storage.template emplace<detail::ErrorIndex>(std::forward<Args>(args)...);
         }
 
-        [[nodiscard]] constexpr const ErrorType& error() const& {
-            if (m_error == std::nullopt) {
-                throw std::runtime_error("Failed to access error of a successful Result");
+        constexpr void unwrap(RESULT_LOCATION) const& {
+            if (!m_storage.has_value()) [[unlikely]] {
+                RESULT_STATS_COUNT(UnwrapFailed, ErrorType, location);
+                RESULT_PROBE(unwrap_failed, ErrorType, location);
+                detail::bad_unwrap<ErrorType>(m_storage.error());
             }
-            return m_error.value();
         }
 
-        [[nodiscard]] constexpr ErrorType&& error() && {
-            if (m_error == std::nullopt) {
-                throw std::runtime_error("Failed to access error of a successful Result");
+        constexpr void unwrap(RESULT_LOCATION) && {
+            if (!m_storage.has_value()) [[unlikely]] {
+                RESULT_STATS_COUNT(UnwrapFailed, ErrorType, location);
+                RESULT_PROBE(unwrap_failed, ErrorType, location);
+                detail::bad_unwrap<ErrorType>(std::move(m_storage.error()));
             }
-            return std::move(m_error).value();
         }
 
-        [[nodiscard]] constexpr bool has_error() const noexcept { return m_error.has_value(); }
+        [[nodiscard]] constexpr ErrorType& error(RESULT_LOCATION) & {
+            return error_impl(*this RESULT_AND_LOCATION_ARG);
+        }
+        [[nodiscard]] constexpr const ErrorType& error(RESULT_LOCATION) const& {
+            return error_impl(*this RESULT_AND_LOCATION_ARG);
+        }
+        [[nodiscard]] constexpr ErrorType&& error(RESULT_LOCATION) && {
+            return error_impl(std::move(*this) RESULT_AND_LOCATION_ARG);
+        }
+        [[nodiscard]] constexpr const ErrorType&& error(RESULT_LOCATION) const&& {
+            return error_impl(std::move(*this) RESULT_AND_LOCATION_ARG);
+        }
+
+        [[nodiscard]] constexpr bool has_error() const noexcept { return !m_storage.has_value(); }
         constexpr operator bool() const noexcept { return !has_error(); }
 
-        template <typename F, typename NewOkType = std::invoke_result_t<F>>
-        [[nodiscard]] constexpr auto map(F f) const & noexcept(std::is_nothrow_invocable_v<F>)
-        -> Result<NewOkType, ErrorType> {
-            if (m_error.has_value()) {
-                return Error{m_error.value()};
-            }
-            if constexpr (std::is_same_v<NewOkType, void>) {
-                f();
-                return Ok<void> {};
-            } else {
-                return Ok{f()};
+        constexpr void unwrap_unchecked() const noexcept {
+            assert(m_storage.has_value() && "unwrap_unchecked() called on an error Result");
+        }
+
+        [[nodiscard]] constexpr const ErrorType& error_unchecked() const& noexcept {
+            assert(!m_storage.has_value() && "error_unchecked() called on a successful Result");
+            return m_storage.error();
+        }
+
+        [[nodiscard]] constexpr ErrorType& error_unchecked() & noexcept {
+            assert(!m_storage.has_value() && "error_unchecked() called on a successful Result");
+            return m_storage.error();
+        }
+
+        [[nodiscard]] constexpr ErrorType&& error_unchecked() && noexcept {
+            assert(!m_storage.has_value() && "error_unchecked() called on a successful Result");
+            return std::move(m_storage.error());
+        }
+
+        constexpr void operator*() const noexcept { unwrap_unchecked(); }
+
+        // f is forwarded and receives the payload with the value category of *this.
+        template <typename F>
+        [[nodiscard]] constexpr auto map(F&& f) & noexcept(noexcept(map_impl(*this, std::forward<F>(f)))) {
+            return map_impl(*this, std::forward<F>(f));
+        }
+        template <typename F>
+        [[nodiscard]] constexpr auto map(F&& f) const& noexcept(noexcept(map_impl(*this, std::forward<F>(f)))) {
+            return map_impl(*this, std::forward<F>(f));
+        }
+        template <typename F>
+        [[nodiscard]] constexpr auto map(F&& f) && noexcept(noexcept(map_impl(std::move(*this), std::forward<F>(f)))) {
+            return map_impl(std::move(*this), std::forward<F>(f));
+        }
+        template <typename F>
+        [[nodiscard]] constexpr auto map(F&& f) const&& noexcept(noexcept(map_impl(std::move(*this), std::forward<F>(f)))) {
+            return map_impl(std::move(*this), std::forward<F>(f));
+        }
+
+        template <typename F>
+        [[nodiscard]] constexpr auto map_error(F&& f RESULT_AND_LOCATION) & noexcept(
+            noexcept(map_error_impl(*this, std::forward<F>(f) RESULT_AND_LOCATION_ARG))) {
+            return map_error_impl(*this, std::forward<F>(f) RESULT_AND_LOCATION_ARG);
+        }
+        template <typename F>
+        [[nodiscard]] constexpr auto map_error(F&& f RESULT_AND_LOCATION) const& noexcept(
+            noexcept(map_error_impl(*this, std::forward<F>(f) RESULT_AND_LOCATION_ARG))) {
+            return map_error_impl(*this, std::forward<F>(f) RESULT_AND_LOCATION_ARG);
+        }
+        template <typename F>
+        [[nodiscard]] constexpr auto map_error(F&& f RESULT_AND_LOCATION) && noexcept(
+            noexcept(map_error_impl(std::move(*this), std::forward<F>(f) RESULT_AND_LOCATION_ARG))) {
+            return map_error_impl(std::move(*this), std::forward<F>(f) RESULT_AND_LOCATION_ARG);
+        }
+        template <typename F>
+        [[nodiscard]] constexpr auto map_error(F&& f RESULT_AND_LOCATION) const&& noexcept(
+            noexcept(map_error_impl(std::move(*this), std::forward<F>(f) RESULT_AND_LOCATION_ARG))) {
+            return map_error_impl(std::move(*this), std::forward<F>(f) RESULT_AND_LOCATION_ARG);
+        }
+
+        template <typename F>
+        constexpr auto and_then(F&& f) & noexcept(noexcept(and_then_impl(*this, std::forward<F>(f)))) {
+            return and_then_impl(*this, std::forward<F>(f));
+        }
+        template <typename F>
+        constexpr auto and_then(F&& f) const& noexcept(noexcept(and_then_impl(*this, std::forward<F>(f)))) {
+            return and_then_impl(*this, std::forward<F>(f));
+        }
+        template <typename F>
+        constexpr auto and_then(F&& f) && noexcept(noexcept(and_then_impl(std::move(*this), std::forward<F>(f)))) {
+            return and_then_impl(std::move(*this), std::forward<F>(f));
+        }
+        template <typename F>
+        constexpr auto and_then(F&& f) const&& noexcept(noexcept(and_then_impl(std::move(*this), std::forward<F>(f)))) {
+            return and_then_impl(std::move(*this), std::forward<F>(f));
+        }
+
+        template <typename F>
+        constexpr auto or_else(F&& f) & noexcept(noexcept(or_else_impl(*this, std::forward<F>(f)))) {
+            return or_else_impl(*this, std::forward<F>(f));
+        }
+        template <typename F>
+        constexpr auto or_else(F&& f) const& noexcept(noexcept(or_else_impl(*this, std::forward<F>(f)))) {
+            return or_else_impl(*this, std::forward<F>(f));
+        }
+        template <typename F>
+        constexpr auto or_else(F&& f) && noexcept(noexcept(or_else_impl(std::move(*this), std::forward<F>(f)))) {
+            return or_else_impl(std::move(*this), std::forward<F>(f));
+        }
+        template <typename F>
+        constexpr auto or_else(F&& f) const&& noexcept(noexcept(or_else_impl(std::move(*this), std::forward<F>(f)))) {
+            return or_else_impl(std::move(*this), std::forward<F>(f));
+        }
+
+        template <typename F>
+        constexpr auto transform(F&& f) & noexcept(noexcept(transform_impl(*this, std::forward<F>(f)))) {
+            return transform_impl(*this, std::forward<F>(f));
+        }
+        template <typename F>
+        constexpr auto transform(F&& f) const& noexcept(noexcept(transform_impl(*this, std::forward<F>(f)))) {
+            return transform_impl(*this, std::forward<F>(f));
+        }
+        template <typename F>
+        constexpr auto transform(F&& f) && noexcept(noexcept(transform_impl(std::move(*this), std::forward<F>(f)))) {
+            return transform_impl(std::move(*this), std::forward<F>(f));
+        }
+        template <typename F>
+        constexpr auto transform(F&& f) const&& noexcept(noexcept(transform_impl(std::move(*this), std::forward<F>(f)))) {
+            return transform_impl(std::move(*this), std::forward<F>(f));
+        }
+
+        template <typename F>
+        constexpr auto transform_error(F&& f) & noexcept(noexcept(transform_error_impl(*this, std::forward<F>(f)))) {
+            return transform_error_impl(*this, std::forward<F>(f));
+        }
+        template <typename F>
+        constexpr auto transform_error(F&& f) const& noexcept(noexcept(transform_error_impl(*this, std::forward<F>(f)))) {
+            return transform_error_impl(*this, std::forward<F>(f));
+        }
+        template <typename F>
+        constexpr auto transform_error(F&& f) && noexcept(noexcept(transform_error_impl(std::move(*this), std::forward<F>(f)))) {
+            return transform_error_impl(std::move(*this), std::forward<F>(f));
+        }
+        template <typename F>
+        constexpr auto transform_error(F&& f) const&& noexcept(noexcept(transform_error_impl(std::move(*this), std::forward<F>(f)))) {
+            return transform_error_impl(std::move(*this), std::forward<F>(f));
+        }
+
+        // Starts a deferred map/map_error chain; see Pipeline.
+        [[nodiscard]] constexpr auto lazy() & noexcept {
+            return Pipeline<Result&, detail::Identity, detail::Identity>(*this, {}, {});
+        }
+        [[nodiscard]] constexpr auto lazy() const& noexcept {
+            return Pipeline<const Result&, detail::Identity, detail::Identity>(*this, {}, {});
+        }
+        [[nodiscard]] constexpr auto lazy() && noexcept {
+            return Pipeline<Result&&, detail::Identity, detail::Identity>(std::move(*this), {}, {});
+        }
+
+    private:
+        template <typename, typename>
+        friend class Result;
+
+        template <typename, typename, typename>
+        friend class Pipeline;
+
+        using StorageType = detail::Storage<detail::Unit, ErrorType>;
+
+        template <std::size_t Index, typename... Args>
+        constexpr static inline bool NothrowStore =
+            std::is_nothrow_constructible_v<StorageType, std::in_place_index_t<Index>, Args...>;
+
+        template <std::size_t Index, typename... Args>
+        constexpr static inline bool NothrowEmplace =
+            noexcept(std::declval<StorageType&>().template emplace<Index>(std::declval<Args>()...));
+
+        template <typename Self>
+        using ErrorRef = detail::ForwardLike<Self, ErrorType>;
+
+        template <std::size_t Index, typename F, typename... Args>
+        constexpr Result(detail::InPlaceInvoke<Index> tag, F&& f, Args&&... args) noexcept(
+            std::is_nothrow_constructible_v<StorageType, detail::InPlaceInvoke<Index>, F, Args...>)
+            : m_storage(tag, std::forward<F>(f), std::forward<Args>(args)...) {}
+
+        template <typename Self>
+        constexpr static ErrorRef<Self> error_impl(Self&& self RESULT_AND_LOCATION) {
+            if (self.m_storage.has_value()) [[unlikely]] {
+                RESULT_STATS_COUNT(BadErrorAccess, ErrorType, location);
+                detail::bad_error_access();
             }
+            return detail::forward_like<Self>(self.m_storage.error());
         }
 
-        template <typename F, typename NewOkType = std::invoke_result_t<F>>
-        [[nodiscard]] constexpr auto map(F f) && noexcept(std::is_nothrow_invocable_v<F>)
+        template <typename Self, typename F, typename NewOkType = std::invoke_result_t<F>>
+        constexpr static auto map_impl(Self&& self, F&& f) noexcept(
+            std::is_nothrow_constructible_v<Result<NewOkType, ErrorType>, InPlaceErrorTag, ErrorRef<Self>> &&
+            detail::nothrow_wrap_invoke<Result<NewOkType, ErrorType>, Ok, F>())
         -> Result<NewOkType, ErrorType> {
-            if (m_error.has_value()) {
-                return Error{std::move(m_error).value()};
+            if (!self.m_storage.has_value()) {
+                return Result<NewOkType, ErrorType>(in_place_error, detail::forward_like<Self>(self.m_storage.error()));
             }
-            if constexpr (std::is_same_v<NewOkType, void>) {
-                f();
+            if constexpr (std::is_void_v<NewOkType>) {
+                std::invoke(std::forward<F>(f));
                 return Ok<void> {};
             } else {
-                return Ok{f()};
+                return Ok {std::invoke(std::forward<F>(f))};
             }
         }
 
-        template <typename F, typename NewErrorType = std::invoke_result_t<F, const ErrorType&>>
-        [[nodiscard]] constexpr auto map_error(F f) const & noexcept(std::is_nothrow_invocable_v<F, const ErrorType&>)
+        template <typename Self, typename F, typename NewErrorType = std::invoke_result_t<F, ErrorRef<Self>>>
+        constexpr static auto map_error_impl(Self&& self, F&& f RESULT_AND_LOCATION) noexcept(
+            std::is_nothrow_constructible_v<Result<void, NewErrorType>, Ok<>> &&
+            detail::nothrow_wrap_invoke<Result<void, NewErrorType>, Error, F, ErrorRef<Self>>())
         -> Result<void, NewErrorType> {
-            if (m_error == std::nullopt) {
+            if (self.m_storage.has_value()) {
                 return Ok<void> {};
             }
-            return Error{f(m_error.value())};
+            RESULT_PROBE(map_error, ErrorType, location);
+            return Error<NewErrorType>(
+                std::invoke(std::forward<F>(f), detail::forward_like<Self>(self.m_storage.error())) RESULT_AND_LOCATION_ARG);
         }
 
-        template <typename F, typename NewErrorType = std::invoke_result_t<F, ErrorType>>
-        [[nodiscard]] constexpr auto map_error(F f) && noexcept(std::is_nothrow_invocable_v<F, ErrorType>)
-        -> Result<void, NewErrorType> {
-            if (m_error == std::nullopt) {
-                return Ok<void> {};
+        template <typename Self, typename F, typename NewResult = detail::Chained<F>>
+        constexpr static auto and_then_impl(Self&& self, F&& f) noexcept(
+            std::is_nothrow_invocable_r_v<NewResult, F> &&
+            std::is_nothrow_constructible_v<NewResult, InPlaceErrorTag, ErrorRef<Self>>) {
+            static_assert(detail::IsResult<NewResult>, "and_then() callable must return a Result");
+            static_assert(std::is_same_v<typename NewResult::error_type, ErrorType>,
+                          "and_then() callable must return a Result with the same error type");
+
+            if (self.has_error()) {
+                return NewResult(in_place_error, detail::forward_like<Self>(self.m_storage.error()));
+            }
+            return std::invoke(std::forward<F>(f));
+        }
+
+        template <typename Self, typename F, typename NewResult = detail::Chained<F, ErrorRef<Self>>>
+        constexpr static auto or_else_impl(Self&& self, F&& f) noexcept(
+            std::is_nothrow_invocable_r_v<NewResult, F, ErrorRef<Self>> &&
+            std::is_nothrow_constructible_v<NewResult, InPlaceOkTag>) {
+            static_assert(detail::IsResult<NewResult>, "or_else() callable must return a Result");
+            static_assert(std::is_void_v<typename NewResult::value_type>,
+                          "or_else() callable must return a Result with the same value type");
+
+            if (self.has_error()) {
+                return std::invoke(std::forward<F>(f), detail::forward_like<Self>(self.m_storage.error()));
+            }
+            return NewResult(in_place_ok);
+        }
+
+        template <typename Self, typename F, typename NewResult = Result<detail::Transformed<F>, ErrorType>>
+        constexpr static auto transform_impl(Self&& self, F&& f) noexcept(
+            detail::nothrow_invoke_into<NewResult, detail::OkIndex, F>() &&
+            std::is_nothrow_constructible_v<NewResult, InPlaceErrorTag, ErrorRef<Self>>) {
+            using NewOkType = typename NewResult::value_type;
+
+            if (self.has_error()) {
+                return NewResult(in_place_error, detail::forward_like<Self>(self.m_storage.error()));
+            }
+            if constexpr (std::is_void_v<NewOkType>) {
+                std::invoke(std::forward<F>(f));
+                return NewResult(in_place_ok);
+            } else {
+                return NewResult(detail::InPlaceInvoke<detail::OkIndex> {}, std::forward<F>(f));
             }
-            return Error{f(std::move(m_error).value())};
         }
 
+        template <typename Self, typename F, typename NewResult = Result<void, detail::Transformed<F, ErrorRef<Self>>>>
+        constexpr static auto transform_error_impl(Self&& self, F&& f) noexcept(
+            detail::nothrow_invoke_into<NewResult, detail::ErrorIndex, F, ErrorRef<Self>>() &&
+            std::is_nothrow_constructible_v<NewResult, InPlaceOkTag>) {
+
+            if (self.has_error()) {
+                return NewResult(detail::InPlaceInvoke<detail::ErrorIndex> {}, std::forward<F>(f),
+                                 detail::forward_like<Self>(self.m_storage.error()));
+            }
+            return NewResult(in_place_ok);
+        }
+
+        StorageType m_storage;
+    };
+
+    template <typename OkType, typename ErrorType, typename... Args>
+    [[nodiscard]] constexpr Result<OkType, ErrorType> make_ok(Args&&... args) {
+        return Result<OkType, ErrorType>(in_place_ok, std::forward<Args>(args)...);
+    }
+
+    template <typename OkType, typename ErrorType, typename... Args>
+    [[nodiscard]] constexpr Result<OkType, ErrorType> make_error(Args&&... args) {
+        return Result<OkType, ErrorType>(in_place_error, std::forward<Args>(args)...);
+    }
+
+    // Deferred chain of map/map_error calls over a Result. Because map and map_error touch
+    // disjoint alternatives, the stages compose into one function per side; run() then tests the
+    // tag once and builds the final Result directly from the composed call, without
+    // materializing the intermediate Results of an eager chain.
+    //
+    // A Pipeline refers to its source Result, so it must be run while that Result is alive,
+    // typically within the same full-expression:
+    //
+    //     Result<std::string, int> r = fetch().lazy().map(parse).map(format).map_error(code).run();
+    template <typename Source, typename OkStage, typename ErrorStage>
+    class Pipeline {
+        using SourceResult = std::remove_cvref_t<Source>;
+        using SourceOkType = typename SourceResult::value_type;
+        using SourceErrorType = typename SourceResult::error_type;
+
+        template <typename Stage, typename T>
+        struct StageResult : std::invoke_result<Stage&, T> {};
+
+        template <typename Stage>
+        struct StageResult<Stage, void> : std::invoke_result<Stage&> {};
+
+        using OkRef = std::conditional_t<std::is_void_v<SourceOkType>, void,
+            decltype(detail::forward_like<Source>(std::declval<std::add_lvalue_reference_t<
+                std::conditional_t<std::is_void_v<SourceOkType>, detail::Unit, SourceOkType>>>()))>;
+        using ErrorRef = decltype(detail::forward_like<Source>(std::declval<SourceErrorType&>()));
+
+    public:
+        using value_type = std::remove_cvref_t<typename StageResult<OkStage, OkRef>::type>;
+        using error_type = std::remove_cvref_t<std::invoke_result_t<ErrorStage&, ErrorRef>>;
+        using result_type = Result<value_type, error_type>;
+
+        constexpr Pipeline(Source source, OkStage ok_stage, ErrorStage error_stage)
+            : m_source(std::forward<Source>(source)),
+              m_ok_stage(std::move(ok_stage)),
+              m_error_stage(std::move(error_stage)) {}
+
+        Pipeline(const Pipeline&) = delete;
+        Pipeline& operator=(const Pipeline&) = delete;
+
+        template <typename F>
+        [[nodiscard]] constexpr auto map(F&& f) && {
+            auto stage = detail::compose(std::move(m_ok_stage), std::forward<F>(f));
+            return Pipeline<Source, decltype(stage), ErrorStage>(
+                std::forward<Source>(m_source), std::move(stage), std::move(m_error_stage));
+        }
+
+        template <typename F>
+        [[nodiscard]] constexpr auto map_error(F&& f) && {
+            auto stage = detail::compose(std::move(m_error_stage), std::forward<F>(f));
+            return Pipeline<Source, OkStage, decltype(stage)>(
+                std::forward<Source>(m_source), std::move(m_ok_stage), std::move(stage));
+        }
+
+        [[nodiscard]] constexpr result_type run() && {
+            if (!m_source.has_error()) {
+                if constexpr (std::is_void_v<value_type>) {
+                    invoke_ok_stage();
+                    return result_type(in_place_ok);
+                } else if constexpr (std::is_void_v<SourceOkType>) {
+                    return result_type(detail::InPlaceInvoke<detail::OkIndex> {}, m_ok_stage);
+                } else {
+                    return result_type(detail::InPlaceInvoke<detail::OkIndex> {}, m_ok_stage,
+                                       detail::forward_like<Source>(m_source.m_storage.ok()));
+                }
+            }
+            return result_type(detail::InPlaceInvoke<detail::ErrorIndex> {}, m_error_stage,
+                               detail::forward_like<Source>(m_source.m_storage.error()));
+        }
+
+        constexpr operator result_type() && { return std::move(*this).run(); }
+
     private:
-        std::optional<ErrorType> m_error;
+        constexpr void invoke_ok_stage() {
+            if constexpr (std::is_void_v<SourceOkType>) {
+                std::invoke(m_ok_stage);
+            } else {
+                std::invoke(m_ok_stage, detail::forward_like<Source>(m_source.m_storage.ok()));
+            }
+        }
+
+        Source m_source;
+        [[no_unique_address]] OkStage m_ok_stage;
+        [[no_unique_address]] ErrorStage m_error_stage;
     };
 }
+
+#define RESULT_DETAIL_CONCAT_IMPL(a, b) a##b
+#define RESULT_DETAIL_CONCAT(a, b) RESULT_DETAIL_CONCAT_IMPL(a, b)
+
+// RESULT_TRY(target, expr) evaluates expr, which must yield a Result. If it holds an error, the
+// error is returned from the enclosing function; otherwise the Ok value initializes target:
+//
+//     RESULT_TRY(int digit, parse_digit(c));
+//     RESULT_TRY(config.port, parse_port(text));
+//
+// RESULT_TRY_VOID(expr) does the same for Results whose value is not needed. GNU statement
+// expressions keep the intermediate Result out of the enclosing scope where they are available;
+// define RESULT_NO_STATEMENT_EXPRESSIONS to force the portable form.
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(RESULT_NO_STATEMENT_EXPRESSIONS)
+#define RESULT_TRY(target, ...)                                                     \
+    target = __extension__({                                                        \
+        auto result_try_value = (__VA_ARGS__);                                      \
+        if (result_try_value.has_error()) {                                         \
+            return ::result::Error {std::move(result_try_value).error_unchecked()}; \
+        }                                                                           \
+        std::move(result_try_value).unwrap_unchecked();                             \
+    })
+#else
+#define RESULT_TRY(target, ...) RESULT_DETAIL_TRY(RESULT_DETAIL_CONCAT(result_try_value_, __LINE__), target, __VA_ARGS__)
+#define RESULT_DETAIL_TRY(name, target, ...)                            \
+    auto name = (__VA_ARGS__);                                          \
+    if (name.has_error()) {                                             \
+        return ::result::Error {std::move(name).error_unchecked()};     \
+    }                                                                   \
+    target = std::move(name).unwrap_unchecked()
+#endif
+
+#define RESULT_TRY_VOID(...)                                                        \
+    do {                                                                            \
+        auto result_try_value = (__VA_ARGS__);                                      \
+        if (result_try_value.has_error()) {                                         \
+            return ::result::Error {std::move(result_try_value).error_unchecked()}; \
+        }                                                                           \
+    } while (false)
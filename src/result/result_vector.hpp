@@ -0,0 +1,213 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "result.hpp"
+
+namespace result {
+    // Structure-of-arrays container for a sequence of Result<OkType, ErrorType>. Ok values are
+    // stored densely in insertion order, a bitmap records which positions succeeded, and errors
+    // live in a sparse table keyed by position. Scanning the successful values is a plain span
+    // walk, and the rare large error does not inflate every element.
+    //
+    // Positions are mapped to Ok slots through a rank table holding the number of Ok values
+    // before each 64-entry bitmap word, so positional access is O(1) for values and
+    // O(log errors) for errors.
+    template <typename OkType, typename ErrorType>
+    class ResultVector {
+    public:
+        using size_type = std::size_t;
+        using value_type = Result<OkType, ErrorType>;
+
+        struct ErrorEntry {
+            size_type index;
+            ErrorType error;
+        };
+
+        ResultVector() = default;
+
+        explicit ResultVector(const std::vector<value_type>& results) {
+            reserve(results.size());
+            for (const value_type& result : results) {
+                push_back(result);
+            }
+        }
+
+        explicit ResultVector(std::vector<value_type>&& results) {
+            reserve(results.size());
+            for (value_type& result : results) {
+                push_back(std::move(result));
+            }
+        }
+
+        void reserve(size_type capacity) {
+            m_oks.reserve(capacity);
+            m_status.reserve(word_count(capacity));
+            m_rank.reserve(word_count(capacity));
+        }
+
+        // Each push either appends the element or, if it throws, leaves the container unchanged.
+        template <typename... Args>
+        OkType& push_ok(Args&&... args) {
+            reserve_status();
+            OkType& value = m_oks.emplace_back(std::forward<Args>(args)...);
+            push_status(true);
+            return value;
+        }
+
+        template <typename... Args>
+        ErrorType& push_error(Args&&... args) {
+            reserve_status();
+            m_errors.push_back(ErrorEntry {m_size, ErrorType(std::forward<Args>(args)...)});
+            push_status(false);
+            return m_errors.back().error;
+        }
+
+        void push_back(const value_type& result) {
+            if (result.has_value()) {
+                push_ok(result.unwrap_unchecked());
+            } else {
+                push_error(result.error_unchecked());
+            }
+        }
+
+        void push_back(value_type&& result) {
+            if (result.has_value()) {
+                push_ok(std::move(result).unwrap_unchecked());
+            } else {
+                push_error(std::move(result).error_unchecked());
+            }
+        }
+
+        [[nodiscard]] size_type size() const noexcept { return m_size; }
+        [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+        [[nodiscard]] size_type ok_count() const noexcept { return m_oks.size(); }
+        [[nodiscard]] size_type error_count() const noexcept { return m_errors.size(); }
+
+        [[nodiscard]] bool has_value(size_type index) const noexcept {
+            assert(index < m_size && "ResultVector index out of range");
+            return (m_status[index / WordBits] >> (index % WordBits)) & 1;
+        }
+
+        [[nodiscard]] bool has_error(size_type index) const noexcept { return !has_value(index); }
+
+        // Ok value at a position that holds one.
+        [[nodiscard]] const OkType& value(size_type index) const noexcept { return m_oks[ok_slot(index)]; }
+        [[nodiscard]] OkType& value(size_type index) noexcept { return m_oks[ok_slot(index)]; }
+
+        // Error at a position that holds one.
+        [[nodiscard]] const ErrorType& error(size_type index) const noexcept { return find_error(index)->error; }
+        [[nodiscard]] ErrorType& error(size_type index) noexcept {
+            return const_cast<ErrorType&>(std::as_const(*this).error(index));
+        }
+
+        [[nodiscard]] value_type get(size_type index) const {
+            if (has_value(index)) {
+                return value_type(in_place_ok, value(index));
+            }
+            return value_type(in_place_error, error(index));
+        }
+
+        // Successful values in insertion order, without the failed positions.
+        [[nodiscard]] std::span<const OkType> oks() const noexcept { return m_oks; }
+        [[nodiscard]] std::span<OkType> oks() noexcept { return m_oks; }
+
+        // Errors with their positions, in insertion order.
+        [[nodiscard]] std::span<const ErrorEntry> errors() const noexcept { return m_errors; }
+
+        // One bit per position, set for Ok; bits past size() are zero.
+        [[nodiscard]] std::span<const std::uint64_t> status_words() const noexcept { return m_status; }
+
+        [[nodiscard]] std::vector<value_type> to_vector() const& {
+            std::vector<value_type> results;
+            results.reserve(m_size);
+            size_type ok = 0;
+            size_type error = 0;
+            for (size_type index = 0; index < m_size; ++index) {
+                if (has_value(index)) {
+                    results.emplace_back(in_place_ok, m_oks[ok++]);
+                } else {
+                    results.emplace_back(in_place_error, m_errors[error++].error);
+                }
+            }
+            return results;
+        }
+
+        [[nodiscard]] std::vector<value_type> to_vector() && {
+            std::vector<value_type> results;
+            results.reserve(m_size);
+            size_type ok = 0;
+            size_type error = 0;
+            for (size_type index = 0; index < m_size; ++index) {
+                if (has_value(index)) {
+                    results.emplace_back(in_place_ok, std::move(m_oks[ok++]));
+                } else {
+                    results.emplace_back(in_place_error, std::move(m_errors[error++].error));
+                }
+            }
+            clear();
+            return results;
+        }
+
+        void clear() noexcept {
+            m_oks.clear();
+            m_errors.clear();
+            m_status.clear();
+            m_rank.clear();
+            m_size = 0;
+        }
+
+    private:
+        constexpr static inline size_type WordBits = 64;
+
+        static constexpr size_type word_count(size_type size) noexcept { return (size + WordBits - 1) / WordBits; }
+
+        template <typename T>
+        static void reserve_one_more(std::vector<T>& words) {
+            if (words.size() == words.capacity()) {
+                words.reserve(std::max<size_type>(2 * words.capacity(), 1));
+            }
+        }
+
+        // Allocates what push_status() needs before the payload is appended, so that it cannot throw
+        // afterwards.
+        void reserve_status() {
+            if (m_size % WordBits == 0) {
+                reserve_one_more(m_status);
+                reserve_one_more(m_rank);
+            }
+        }
+
+        void push_status(bool ok) noexcept {
+            if (m_size % WordBits == 0) {
+                m_rank.push_back(static_cast<size_type>(m_oks.size() - (ok ? 1 : 0)));
+                m_status.push_back(0);
+            }
+            m_status.back() |= static_cast<std::uint64_t>(ok) << (m_size % WordBits);
+            ++m_size;
+        }
+
+        size_type ok_slot(size_type index) const noexcept {
+            assert(has_value(index) && "ResultVector position does not hold a value");
+            std::uint64_t below = m_status[index / WordBits] & ((std::uint64_t {1} << (index % WordBits)) - 1);
+            return m_rank[index / WordBits] + static_cast<size_type>(std::popcount(below));
+        }
+
+        const ErrorEntry* find_error(size_type index) const noexcept {
+            assert(has_error(index) && "ResultVector position does not hold an error");
+            return std::lower_bound(m_errors.data(), m_errors.data() + m_errors.size(), index,
+                                    [](const ErrorEntry& entry, size_type i) { return entry.index < i; });
+        }
+
+        std::vector<OkType> m_oks;
+        std::vector<ErrorEntry> m_errors;
+        std::vector<std::uint64_t> m_status;
+        std::vector<size_type> m_rank;
+        size_type m_size = 0;
+    };
+}
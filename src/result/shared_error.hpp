@@ -0,0 +1,99 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "result.hpp"
+
+namespace result {
+    // An immutable error shared by reference counting. Copying one, and so copying or propagating a
+    // Result that holds one (e.g. through map() const&), increments an atomic count instead of copying
+    // the error; only constructing it allocates. A moved-from SharedError is empty and may only be
+    // assigned to or destroyed.
+    template <typename E>
+    class SharedError {
+        static_assert(std::is_object_v<E> && !std::is_const_v<E>, "SharedError holds a non-const object type");
+
+    public:
+        using element_type = E;
+
+        template <typename T = E>
+            requires(!std::same_as<std::remove_cvref_t<T>, SharedError> &&
+                     !std::same_as<std::remove_cvref_t<T>, std::in_place_t> && std::convertible_to<T, E>)
+        SharedError(T&& error) : m_block(new Block(std::forward<T>(error))) {}
+
+        template <typename... Args>
+            requires std::constructible_from<E, Args...>
+        explicit SharedError(std::in_place_t, Args&&... args) : m_block(new Block(std::forward<Args>(args)...)) {}
+
+        SharedError(const SharedError& other) noexcept : m_block(other.m_block) {
+            if (m_block != nullptr) {
+                m_block->references.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        SharedError(SharedError&& other) noexcept : m_block(std::exchange(other.m_block, nullptr)) {}
+
+        SharedError& operator=(SharedError other) noexcept {
+            std::swap(m_block, other.m_block);
+            return *this;
+        }
+
+        ~SharedError() {
+            if (m_block != nullptr && m_block->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                delete m_block;
+            }
+        }
+
+        [[nodiscard]] const E& get() const noexcept {
+            assert(m_block != nullptr && "SharedError accessed after being moved from");
+            return m_block->value;
+        }
+
+        [[nodiscard]] const E& operator*() const noexcept { return get(); }
+        [[nodiscard]] const E* operator->() const noexcept { return &get(); }
+
+        // Number of SharedErrors referring to this error; 0 once moved from.
+        [[nodiscard]] std::size_t use_count() const noexcept {
+            return m_block != nullptr ? m_block->references.load(std::memory_order_relaxed) : 0;
+        }
+
+        friend bool operator==(const SharedError& lhs, const SharedError& rhs) requires std::equality_comparable<E>
+        {
+            return lhs.m_block == rhs.m_block || lhs.get() == rhs.get();
+        }
+
+        friend bool operator==(const SharedError& lhs, const E& rhs) requires std::equality_comparable<E>
+        {
+            return lhs.get() == rhs;
+        }
+
+    private:
+        struct Block {
+            template <typename... Args>
+            explicit Block(Args&&... args) : value(std::forward<Args>(args)...) {}
+
+            std::atomic<std::size_t> references {1};
+            const E value;
+        };
+
+        Block* m_block;
+    };
+
+    template <typename E>
+        requires HasErrorDescription<E> || std::convertible_to<const E&, std::string_view>
+    struct ErrorDescription<SharedError<E>> {
+        static decltype(auto) description(const SharedError<E>& error) {
+            if constexpr (HasErrorDescription<E>) {
+                return ErrorDescription<E>::description(*error);
+            } else {
+                return std::string_view(*error);
+            }
+        }
+    };
+}
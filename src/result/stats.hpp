@@ -0,0 +1,260 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string_view>
+#include <vector>
+
+#ifdef RESULT_ENABLE_STATS
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <source_location>
+#include <tuple>
+
+#include "type_name.hpp"
+#endif
+
+// Define RESULT_ENABLE_STATS to count, per error type and call site, how often Errors are
+// constructed, unwrap() fails and error() is called on a successful Result. Counters are
+// thread-local; snapshot() and dump() aggregate every thread. Without the macro the hooks compile
+// to nothing and snapshot() is always empty. The macro must be defined consistently across the
+// program, since it changes the signatures of Error's constructors, unwrap(), error() and map_error().
+namespace result::stats {
+    enum class Event : std::uint8_t {
+        ErrorConstructed,
+        UnwrapFailed,
+        BadErrorAccess,
+    };
+
+    [[nodiscard]] constexpr std::string_view to_string(Event event) noexcept {
+        switch (event) {
+        case Event::ErrorConstructed: return "error";
+        case Event::UnwrapFailed: return "unwrap_failed";
+        case Event::BadErrorAccess: return "bad_error_access";
+        }
+        return "unknown";
+    }
+
+    struct Counter {
+        Event event;
+        std::string_view type;
+        std::string_view file;
+        std::string_view function;
+        std::uint_least32_t line;
+        std::uint_least32_t column;
+        std::uint64_t count;
+    };
+
+    struct Snapshot {
+        // Sorted by descending count.
+        std::vector<Counter> counters;
+        // Events not recorded because a thread's table was full.
+        std::uint64_t dropped = 0;
+    };
+
+#ifdef RESULT_ENABLE_STATS
+    constexpr inline bool enabled = true;
+
+    namespace detail {
+        struct TypeInfo {
+            std::string_view name;
+        };
+
+        template <typename T>
+        constexpr inline TypeInfo type_info {result::detail::type_name<T>()};
+
+        struct Slot {
+            // Written last by the owning thread, so readers that see it also see the other fields.
+            std::atomic<const TypeInfo*> type {nullptr};
+            Event event {};
+            std::uint_least32_t line = 0;
+            std::uint_least32_t column = 0;
+            const char* file = nullptr;
+            const char* function = nullptr;
+            std::atomic<std::uint64_t> count {0};
+        };
+
+        // Open-addressing table owned by one thread. Only the owner inserts, so insertion needs no
+        // synchronization beyond publishing the slot; counts are atomics so that other threads can
+        // read and reset them.
+        class ThreadTable {
+        public:
+            constexpr static inline std::size_t Capacity = 512;
+
+            void add(const TypeInfo* type, Event event, const std::source_location& location) noexcept {
+                std::uint64_t hash = reinterpret_cast<std::uintptr_t>(type) ^ reinterpret_cast<std::uintptr_t>(location.file_name());
+                hash = (hash ^ (std::uint64_t {location.line()} << 16) ^ location.column() ^ static_cast<std::uint64_t>(event)) *
+                       0x9e3779b97f4a7c15u;
+                for (std::size_t probe = 0; probe < Capacity; ++probe) {
+                    Slot& slot = m_slots[((hash >> 32) + probe) % Capacity];
+                    const TypeInfo* current = slot.type.load(std::memory_order_relaxed);
+                    if (current == nullptr) {
+                        slot.event = event;
+                        slot.line = location.line();
+                        slot.column = location.column();
+                        slot.file = location.file_name();
+                        slot.function = location.function_name();
+                        slot.count.store(1, std::memory_order_relaxed);
+                        slot.type.store(type, std::memory_order_release);
+                        return;
+                    }
+                    if (current == type && slot.event == event && slot.line == location.line() &&
+                        slot.column == location.column() && slot.file == location.file_name()) {
+                        slot.count.fetch_add(1, std::memory_order_relaxed);
+                        return;
+                    }
+                }
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            void collect(Snapshot& snapshot) const {
+                for (const Slot& slot : m_slots) {
+                    const TypeInfo* type = slot.type.load(std::memory_order_acquire);
+                    std::uint64_t count = slot.count.load(std::memory_order_relaxed);
+                    if (type != nullptr && count != 0) {
+                        snapshot.counters.push_back(
+                            {slot.event, type->name, slot.file, slot.function, slot.line, slot.column, count});
+                    }
+                }
+                snapshot.dropped += m_dropped.load(std::memory_order_relaxed);
+            }
+
+            void reset() noexcept {
+                for (Slot& slot : m_slots) {
+                    slot.count.store(0, std::memory_order_relaxed);
+                }
+                m_dropped.store(0, std::memory_order_relaxed);
+            }
+
+        private:
+            Slot m_slots[Capacity];
+            std::atomic<std::uint64_t> m_dropped {0};
+        };
+
+        // Combines counters with the same event, type and call site.
+        inline void merge(std::vector<Counter>& counters) {
+            auto key = [](const Counter& counter) {
+                return std::tuple(counter.event, counter.type, counter.file, counter.line, counter.column);
+            };
+            std::sort(counters.begin(), counters.end(), [&](const Counter& lhs, const Counter& rhs) { return key(lhs) < key(rhs); });
+
+            std::size_t size = 0;
+            for (const Counter& counter : counters) {
+                if (size != 0 && key(counters[size - 1]) == key(counter)) {
+                    counters[size - 1].count += counter.count;
+                } else {
+                    counters[size++] = counter;
+                }
+            }
+            counters.resize(size);
+        }
+
+        // Tables of live threads, plus the counts of threads that have exited.
+        struct Registry {
+            std::mutex mutex;
+            std::vector<ThreadTable*> tables;
+            Snapshot retired;
+        };
+
+        // Never destroyed, as threads may still exit after static destruction has begun.
+        inline Registry& registry() {
+            static Registry* registry = new Registry;
+            return *registry;
+        }
+
+        class ThreadTableHandle {
+        public:
+            ThreadTableHandle() noexcept : m_table(new (std::nothrow) ThreadTable) {
+                if (m_table != nullptr) {
+                    std::lock_guard lock(registry().mutex);
+                    registry().tables.push_back(m_table);
+                }
+            }
+
+            ThreadTableHandle(const ThreadTableHandle&) = delete;
+            ThreadTableHandle& operator=(const ThreadTableHandle&) = delete;
+
+            ~ThreadTableHandle() {
+                if (m_table != nullptr) {
+                    Registry& shared = registry();
+                    std::lock_guard lock(shared.mutex);
+                    m_table->collect(shared.retired);
+                    merge(shared.retired.counters);
+                    std::erase(shared.tables, m_table);
+                    delete m_table;
+                }
+            }
+
+            [[nodiscard]] ThreadTable* table() const noexcept { return m_table; }
+
+        private:
+            ThreadTable* m_table;
+        };
+
+        // One table per thread, shared by every error type; slots are keyed by the type's TypeInfo.
+        inline ThreadTable* this_thread_table() noexcept {
+            thread_local ThreadTableHandle handle;
+            return handle.table();
+        }
+
+        template <typename T>
+        void count(Event event, const std::source_location& location) noexcept {
+            if (ThreadTable* table = this_thread_table()) {
+                table->add(&type_info<T>, event, location);
+            }
+        }
+    }
+
+    // Counts of every thread, merged by event, type and call site.
+    [[nodiscard]] inline Snapshot snapshot() {
+        Snapshot current;
+        {
+            detail::Registry& shared = detail::registry();
+            std::lock_guard lock(shared.mutex);
+            current = shared.retired;
+            for (const detail::ThreadTable* table : shared.tables) {
+                table->collect(current);
+            }
+        }
+
+        detail::merge(current.counters);
+        std::stable_sort(current.counters.begin(), current.counters.end(),
+                         [](const Counter& lhs, const Counter& rhs) { return lhs.count > rhs.count; });
+        return current;
+    }
+
+    // Zeroes the counters of every thread.
+    inline void reset() {
+        detail::Registry& shared = detail::registry();
+        std::lock_guard lock(shared.mutex);
+        shared.retired = {};
+        for (detail::ThreadTable* table : shared.tables) {
+            table->reset();
+        }
+    }
+#else
+    constexpr inline bool enabled = false;
+
+    [[nodiscard]] inline Snapshot snapshot() { return {}; }
+
+    inline void reset() {}
+#endif
+
+    // Writes one line per counter: count, event, error type and call site.
+    inline void dump(std::FILE* out = stderr) {
+        Snapshot current = snapshot();
+        for (const Counter& counter : current.counters) {
+            std::string_view event = to_string(counter.event);
+            std::fprintf(out, "%12llu  %-16.*s  %.*s  %.*s:%u:%u  %.*s\n", static_cast<unsigned long long>(counter.count),
+                         static_cast<int>(event.size()), event.data(), static_cast<int>(counter.type.size()),
+                         counter.type.data(), static_cast<int>(counter.file.size()), counter.file.data(),
+                         static_cast<unsigned>(counter.line), static_cast<unsigned>(counter.column),
+                         static_cast<int>(counter.function.size()), counter.function.data());
+        }
+        if (current.dropped != 0) {
+            std::fprintf(out, "%12llu  dropped\n", static_cast<unsigned long long>(current.dropped));
+        }
+    }
+}
@@ -0,0 +1,705 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#ifndef RESULT_NO_EXCEPTIONS
+#include <exception>
+#include <stdexcept>
+#endif
+
+#include "coroutine.hpp"
+#include "result.hpp"
+
+// Asynchronous coroutines producing a Result. A Task<Result<T, E>> starts when it is awaited (or
+// passed to sync_wait, when_all or when_any) and completes with the Result it co_returns. Inside a
+// task, co_await on another task yields that task's Result, and co_await on a Result unwraps it or
+// completes the task with its error:
+//
+//     Task<Result<Config, IoError>> load(ThreadPool& pool, std::string path) {
+//         co_await pool.schedule();
+//         std::string text = co_await read_file(path);
+//         co_return parse_config(text);
+//     }
+//
+// Continuations are stored in the promise, so resuming or joining tasks allocates nothing beyond
+// the coroutine frames, which are recycled through the per-thread frame cache.
+namespace result {
+    template <typename ResultType>
+        requires detail::IsResult<ResultType>
+    class Task;
+
+    class ThreadPool;
+
+    namespace detail {
+        // Cancellation request shared by the children of a join. Flags chain to the enclosing join's
+        // flag, so stopping an outer join also stops tasks nested inside inner ones.
+        struct StopFlag {
+            [[nodiscard]] bool requested() const noexcept {
+                for (const StopFlag* flag = this; flag; flag = flag->parent) {
+                    if (flag->stopped.load(std::memory_order_acquire)) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            std::atomic<bool> stopped {false};
+            const StopFlag* parent = nullptr;
+        };
+
+        class TaskPromiseBase;
+
+        // What runs when a task completes: either the awaiting coroutine, or a callback that decides
+        // which coroutine to transfer to.
+        struct Continuation {
+            std::coroutine_handle<> handle = std::noop_coroutine();
+            std::coroutine_handle<> (*callback)(void* context, TaskPromiseBase& completed) noexcept = nullptr;
+            void* context = nullptr;
+        };
+
+        class TaskPromiseBase {
+        public:
+            struct FinalAwaiter {
+                bool await_ready() const noexcept { return false; }
+
+                template <typename Promise>
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+                    return handle.promise().complete();
+                }
+
+                void await_resume() const noexcept {}
+            };
+
+            std::suspend_always initial_suspend() const noexcept { return {}; }
+            FinalAwaiter final_suspend() const noexcept { return {}; }
+
+            [[nodiscard]] bool stop_requested() const noexcept { return m_stop && m_stop->requested(); }
+
+            // Ends the task at a suspension point without a Result. The cancellation spreads to the
+            // tasks awaiting this one up to the task started by a join, whose owner discards it.
+            std::coroutine_handle<> cancel() noexcept {
+                TaskPromiseBase* root = this;
+                root->m_cancelled = true;
+                while (root->m_parent) {
+                    root = root->m_parent;
+                    root->m_cancelled = true;
+                }
+                return root->complete();
+            }
+
+            std::coroutine_handle<> complete() noexcept {
+                if (m_continuation.callback) {
+                    return m_continuation.callback(m_continuation.context, *this);
+                }
+                return m_continuation.handle;
+            }
+
+            static void* operator new(std::size_t size) { return FrameCache::local().allocate(size); }
+            static void operator delete(void* pointer, std::size_t size) noexcept {
+                FrameCache::local().deallocate(pointer, size);
+            }
+
+            Continuation m_continuation;
+            TaskPromiseBase* m_parent = nullptr;
+            const StopFlag* m_stop = nullptr;
+            bool m_failed = false;
+            bool m_cancelled = false;
+        };
+
+        template <typename ResultType>
+        class TaskPromise : public TaskPromiseBase {
+        public:
+            Task<ResultType> get_return_object() noexcept {
+                return Task<ResultType>(std::coroutine_handle<TaskPromise>::from_promise(*this));
+            }
+
+            template <typename T>
+                requires(std::is_constructible_v<ResultType, T &&>)
+            void return_value(T&& value) {
+                m_failed = m_result.emplace(std::forward<T>(value)).has_error();
+            }
+
+            void unhandled_exception() {
+#ifdef RESULT_NO_EXCEPTIONS
+                panic("Unhandled exception in Task");
+#else
+                m_exception = std::current_exception();
+                m_failed = true;
+#endif
+            }
+
+            template <typename E>
+            std::coroutine_handle<> short_circuit(std::coroutine_handle<TaskPromise>, E&& error) {
+                m_result.emplace(in_place_error, std::forward<E>(error));
+                m_failed = true;
+                return complete();
+            }
+
+            template <typename Awaited>
+                requires(IsResult<std::remove_cvref_t<Awaited>>)
+            ResultAwaiter<Awaited> await_transform(Awaited&& awaited) noexcept {
+                return ResultAwaiter<Awaited>(std::forward<Awaited>(awaited));
+            }
+
+            template <typename Awaitable>
+                requires(!IsResult<std::remove_cvref_t<Awaitable>>)
+            Awaitable&& await_transform(Awaitable&& awaitable) noexcept {
+                return std::forward<Awaitable>(awaitable);
+            }
+
+            ResultType take_result() {
+#ifndef RESULT_NO_EXCEPTIONS
+                if (m_exception) {
+                    std::rethrow_exception(m_exception);
+                }
+#endif
+                if (!m_result) {
+                    panic("Task completed without producing a Result");
+                }
+                return std::move(*m_result);
+            }
+
+        private:
+            std::optional<ResultType> m_result;
+#ifndef RESULT_NO_EXCEPTIONS
+            std::exception_ptr m_exception;
+#endif
+        };
+
+        struct ChildRef {
+            std::coroutine_handle<> handle;
+            TaskPromiseBase* promise;
+        };
+
+        struct TaskAccess {
+            template <typename ResultType>
+            static ChildRef child(Task<ResultType>& task) noexcept {
+                return {task.m_handle, &task.m_handle.promise()};
+            }
+
+            template <typename ResultType>
+            static ResultType take(Task<ResultType>& task) {
+                return task.m_handle.promise().take_result();
+            }
+        };
+
+        template <typename Promise>
+        constexpr inline bool IsTaskPromise = std::is_base_of_v<TaskPromiseBase, Promise>;
+    }
+
+    template <typename ResultType>
+        requires detail::IsResult<ResultType>
+    class [[nodiscard]] Task {
+    public:
+        using promise_type = detail::TaskPromise<ResultType>;
+        using result_type = ResultType;
+
+        Task(Task&& other) noexcept : m_handle(std::exchange(other.m_handle, {})) {}
+
+        Task& operator=(Task&& other) noexcept {
+            if (this != &other) {
+                if (m_handle) {
+                    m_handle.destroy();
+                }
+                m_handle = std::exchange(other.m_handle, {});
+            }
+            return *this;
+        }
+
+        ~Task() {
+            if (m_handle) {
+                m_handle.destroy();
+            }
+        }
+
+        class Awaiter {
+        public:
+            explicit Awaiter(std::coroutine_handle<promise_type> handle) noexcept : m_handle(handle) {}
+
+            bool await_ready() const noexcept { return false; }
+
+            template <typename Promise>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> awaiting) noexcept {
+                promise_type& promise = m_handle.promise();
+                promise.m_continuation = {awaiting, nullptr, nullptr};
+                if constexpr (detail::IsTaskPromise<Promise>) {
+                    promise.m_parent = &awaiting.promise();
+                    promise.m_stop = awaiting.promise().m_stop;
+                    if (awaiting.promise().stop_requested()) {
+                        return awaiting.promise().cancel();
+                    }
+                }
+                return m_handle;
+            }
+
+            ResultType await_resume() { return m_handle.promise().take_result(); }
+
+        private:
+            std::coroutine_handle<promise_type> m_handle;
+        };
+
+        // Starts the task and resumes the awaiting coroutine with its Result once it completes.
+        Awaiter operator co_await() && noexcept { return Awaiter(m_handle); }
+
+    private:
+        friend promise_type;
+        friend struct detail::TaskAccess;
+
+        explicit Task(std::coroutine_handle<promise_type> handle) noexcept : m_handle(handle) {}
+
+        std::coroutine_handle<promise_type> m_handle;
+    };
+
+    // co_await cancellation_point() ends the current task if its join has been stopped; otherwise
+    // it continues without suspending. ThreadPool::schedule() and awaiting a task check as well.
+    namespace detail {
+        struct CancellationPoint {
+            bool await_ready() const noexcept { return false; }
+
+            template <typename Promise>
+                requires IsTaskPromise<Promise>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+                return handle.promise().stop_requested() ? handle.promise().cancel() : handle;
+            }
+
+            void await_resume() const noexcept {}
+        };
+    }
+
+    inline detail::CancellationPoint cancellation_point() noexcept { return {}; }
+
+    namespace detail {
+        // Per-worker queue of runnable coroutines. The owner pushes and pops at the back; idle
+        // workers steal from the front. The ring buffer only allocates when it grows.
+        class WorkQueue {
+        public:
+            void push(std::coroutine_handle<> handle) {
+                std::lock_guard lock(m_mutex);
+                if (m_size == m_buffer.size()) {
+                    grow();
+                }
+                m_buffer[(m_head + m_size) & (m_buffer.size() - 1)] = handle;
+                ++m_size;
+            }
+
+            std::coroutine_handle<> pop() {
+                std::lock_guard lock(m_mutex);
+                if (m_size == 0) {
+                    return nullptr;
+                }
+                --m_size;
+                return m_buffer[(m_head + m_size) & (m_buffer.size() - 1)];
+            }
+
+            std::coroutine_handle<> steal() {
+                std::lock_guard lock(m_mutex);
+                if (m_size == 0) {
+                    return nullptr;
+                }
+                std::coroutine_handle<> handle = m_buffer[m_head];
+                m_head = (m_head + 1) & (m_buffer.size() - 1);
+                --m_size;
+                return handle;
+            }
+
+        private:
+            constexpr static inline std::size_t InitialCapacity = 64;
+
+            void grow() {
+                std::vector<std::coroutine_handle<>> buffer(m_buffer.empty() ? InitialCapacity : m_buffer.size() * 2);
+                for (std::size_t i = 0; i < m_size; ++i) {
+                    buffer[i] = m_buffer[(m_head + i) & (m_buffer.size() - 1)];
+                }
+                m_buffer = std::move(buffer);
+                m_head = 0;
+            }
+
+            std::mutex m_mutex;
+            std::vector<std::coroutine_handle<>> m_buffer;
+            std::size_t m_head = 0;
+            std::size_t m_size = 0;
+        };
+    }
+
+    // Work-stealing pool of worker threads that resume coroutines. Coroutines scheduled from a
+    // worker go to that worker's queue, others are spread round-robin; idle workers take work from
+    // the other queues. The destructor runs the remaining work and joins the workers.
+    class ThreadPool {
+    public:
+        explicit ThreadPool(std::size_t threads = std::max(1u, std::thread::hardware_concurrency()))
+            : m_queues(std::make_unique<detail::WorkQueue[]>(threads)), m_queue_count(threads) {
+            assert(threads > 0 && "ThreadPool needs at least one thread");
+            m_workers.reserve(threads);
+            for (std::size_t i = 0; i < threads; ++i) {
+                m_workers.emplace_back([this, i] { run(i); });
+            }
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        ~ThreadPool() {
+            {
+                std::lock_guard lock(m_mutex);
+                m_stopping = true;
+            }
+            m_wake.notify_all();
+            m_workers.clear();
+        }
+
+        class ScheduleAwaiter {
+        public:
+            explicit ScheduleAwaiter(ThreadPool& pool) noexcept : m_pool(&pool) {}
+
+            bool await_ready() const noexcept { return false; }
+
+            template <typename Promise>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) {
+                if constexpr (detail::IsTaskPromise<Promise>) {
+                    if (handle.promise().stop_requested()) {
+                        return handle.promise().cancel();
+                    }
+                }
+                m_pool->enqueue(handle);
+                return std::noop_coroutine();
+            }
+
+            void await_resume() const noexcept {}
+
+        private:
+            ThreadPool* m_pool;
+        };
+
+        // co_await pool.schedule() continues the awaiting coroutine on one of the workers.
+        [[nodiscard]] ScheduleAwaiter schedule() noexcept { return ScheduleAwaiter(*this); }
+
+        void enqueue(std::coroutine_handle<> handle) {
+            Worker& worker = current_worker();
+            std::size_t queue = worker.pool == this ? worker.index
+                                                    : m_next_queue.fetch_add(1, std::memory_order_relaxed) % m_queue_count;
+            m_queues[queue].push(handle);
+            m_pending.fetch_add(1, std::memory_order_release);
+            {
+                std::lock_guard lock(m_mutex);
+            }
+            m_wake.notify_one();
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept { return m_queue_count; }
+
+    private:
+        struct Worker {
+            ThreadPool* pool = nullptr;
+            std::size_t index = 0;
+        };
+
+        static Worker& current_worker() noexcept {
+            thread_local Worker worker;
+            return worker;
+        }
+
+        std::coroutine_handle<> find_work(std::size_t index) {
+            if (std::coroutine_handle<> handle = m_queues[index].pop()) {
+                return handle;
+            }
+            for (std::size_t offset = 1; offset < m_queue_count; ++offset) {
+                if (std::coroutine_handle<> handle = m_queues[(index + offset) % m_queue_count].steal()) {
+                    return handle;
+                }
+            }
+            return nullptr;
+        }
+
+        void run(std::size_t index) {
+            current_worker() = {this, index};
+            for (;;) {
+                if (std::coroutine_handle<> handle = find_work(index)) {
+                    m_pending.fetch_sub(1, std::memory_order_relaxed);
+                    handle.resume();
+                    continue;
+                }
+                std::unique_lock lock(m_mutex);
+                m_wake.wait(lock, [this] { return m_pending.load(std::memory_order_acquire) > 0 || m_stopping; });
+                if (m_stopping && m_pending.load(std::memory_order_acquire) == 0) {
+                    return;
+                }
+            }
+        }
+
+        std::unique_ptr<detail::WorkQueue[]> m_queues;
+        std::size_t m_queue_count;
+        std::atomic<std::size_t> m_next_queue {0};
+        std::atomic<std::size_t> m_pending {0};
+        std::mutex m_mutex;
+        std::condition_variable m_wake;
+        bool m_stopping = false;
+        std::vector<std::jthread> m_workers;
+    };
+
+    // Runs a task to completion, blocking the calling thread, and returns its Result. Must not be
+    // called from a worker of a pool the task depends on.
+    template <typename ResultType>
+    ResultType sync_wait(Task<ResultType> task) {
+        struct Signal {
+            std::mutex mutex;
+            std::condition_variable done_changed;
+            bool done = false;
+        } signal;
+
+        detail::ChildRef child = detail::TaskAccess::child(task);
+        child.promise->m_continuation.callback = [](void* context, detail::TaskPromiseBase&) noexcept -> std::coroutine_handle<> {
+            auto& signal = *static_cast<Signal*>(context);
+            std::lock_guard lock(signal.mutex);
+            signal.done = true;
+            signal.done_changed.notify_one();
+            return std::noop_coroutine();
+        };
+        child.promise->m_continuation.context = &signal;
+        child.handle.resume();
+
+        std::unique_lock lock(signal.mutex);
+        signal.done_changed.wait(lock, [&] { return signal.done; });
+        return detail::TaskAccess::take(task);
+    }
+
+    namespace detail {
+        struct JoinOutcome {
+            TaskPromiseBase* first_success;
+            TaskPromiseBase* first_failure;
+            bool cancelled;
+        };
+
+        enum class JoinMode { All, Any };
+
+        // Starts every child and resumes the awaiting task once all of them have completed or been
+        // cancelled. The first failure (All) or the first success (Any) stops the remaining children.
+        // The count starts one above the number of children so that children completing while they
+        // are being started cannot resume the awaiting task early. The state lives in the awaiting
+        // frame and is awaited through the copyable Awaiter returned by wait().
+        template <JoinMode Mode>
+        class Join {
+        public:
+            class Awaiter {
+            public:
+                explicit Awaiter(Join& join) noexcept : m_join(&join) {}
+
+                bool await_ready() const noexcept { return m_join->m_children.empty(); }
+
+                template <typename Promise>
+                bool await_suspend(std::coroutine_handle<Promise> awaiting) noexcept {
+                    return m_join->start(awaiting, awaiting.promise().m_stop);
+                }
+
+                JoinOutcome await_resume() const noexcept {
+                    return {m_join->m_first_success.load(std::memory_order_acquire),
+                            m_join->m_first_failure.load(std::memory_order_acquire),
+                            m_join->m_cancelled.load(std::memory_order_acquire)};
+                }
+
+            private:
+                Join* m_join;
+            };
+
+            explicit Join(std::span<const ChildRef> children) noexcept : m_children(children) {}
+
+            Join(const Join&) = delete;
+            Join& operator=(const Join&) = delete;
+
+            [[nodiscard]] Awaiter wait() noexcept { return Awaiter(*this); }
+
+        private:
+            bool start(std::coroutine_handle<> awaiting, const StopFlag* parent_stop) noexcept {
+                m_awaiting = awaiting;
+                m_stop.parent = parent_stop;
+                m_remaining.store(m_children.size() + 1, std::memory_order_relaxed);
+                for (const ChildRef& child : m_children) {
+                    child.promise->m_continuation = {std::noop_coroutine(), &Join::on_complete, this};
+                    child.promise->m_parent = nullptr;
+                    child.promise->m_stop = &m_stop;
+                    if (m_stop.requested()) {
+                        child.promise->m_cancelled = true;
+                        m_cancelled.store(true, std::memory_order_relaxed);
+                        m_remaining.fetch_sub(1, std::memory_order_relaxed);
+                        continue;
+                    }
+                    child.handle.resume();
+                }
+                return m_remaining.fetch_sub(1, std::memory_order_acq_rel) > 1;
+            }
+
+            static std::coroutine_handle<> on_complete(void* context, TaskPromiseBase& completed) noexcept {
+                auto* self = static_cast<Join*>(context);
+                if (completed.m_cancelled) {
+                    self->m_cancelled.store(true, std::memory_order_relaxed);
+                } else {
+                    std::atomic<TaskPromiseBase*>& first = completed.m_failed ? self->m_first_failure : self->m_first_success;
+                    TaskPromiseBase* expected = nullptr;
+                    if (first.compare_exchange_strong(expected, &completed, std::memory_order_acq_rel) &&
+                        completed.m_failed == (Mode == JoinMode::All)) {
+                        self->m_stop.stopped.store(true, std::memory_order_release);
+                    }
+                }
+                if (self->m_remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    return self->m_awaiting;
+                }
+                return std::noop_coroutine();
+            }
+
+            std::span<const ChildRef> m_children;
+            std::coroutine_handle<> m_awaiting;
+            StopFlag m_stop;
+            std::atomic<std::size_t> m_remaining {0};
+            std::atomic<TaskPromiseBase*> m_first_success {nullptr};
+            std::atomic<TaskPromiseBase*> m_first_failure {nullptr};
+            std::atomic<bool> m_cancelled {false};
+        };
+
+        template <typename ResultType>
+        std::vector<ChildRef> children_of(std::vector<Task<ResultType>>& tasks) {
+            std::vector<ChildRef> children;
+            children.reserve(tasks.size());
+            for (Task<ResultType>& task : tasks) {
+                children.push_back(TaskAccess::child(task));
+            }
+            return children;
+        }
+
+        // What when_all() collects from a child: its value, or an empty slot for a Result<void>.
+        template <typename OkType>
+        using JoinSlot = std::conditional_t<std::is_void_v<OkType>, std::monostate, OkType>;
+
+        template <typename OkType, typename ErrorType>
+        JoinSlot<OkType> take_value(Task<Result<OkType, ErrorType>>& task) {
+            if constexpr (std::is_void_v<OkType>) {
+                static_cast<void>(TaskAccess::take(task));
+                return {};
+            } else {
+                return TaskAccess::take(task).unwrap_unchecked();
+            }
+        }
+
+        // Result<void, E> when no child has a value to collect.
+        template <typename ErrorType, typename... OkTypes>
+        using WhenAllResult = std::conditional_t<(std::is_void_v<OkTypes> && ...), Result<void, ErrorType>,
+                                                 Result<std::tuple<JoinSlot<OkTypes>...>, ErrorType>>;
+
+        template <typename ErrorType, typename OkType>
+        using WhenAllVectorResult =
+            std::conditional_t<std::is_void_v<OkType>, Result<void, ErrorType>, Result<std::vector<OkType>, ErrorType>>;
+
+        [[noreturn]] RESULT_COLD inline void no_tasks(const char* message) {
+#ifdef RESULT_NO_EXCEPTIONS
+            panic(message);
+#else
+            throw std::invalid_argument(message);
+#endif
+        }
+    }
+
+    // Runs the tasks concurrently and completes with all of their values, or with the error of the
+    // first task to fail, in which case the others are cancelled at their next suspension point.
+    // Result<void> tasks contribute a std::monostate to the tuple; if no task has a value, the join
+    // completes with Result<void, E>. Tasks run on the awaiting thread until they first suspend, so
+    // tasks that should run in parallel start with co_await pool.schedule().
+    template <typename ErrorType, typename... OkTypes>
+    Task<detail::WhenAllResult<ErrorType, OkTypes...>> when_all(Task<Result<OkTypes, ErrorType>>... tasks) {
+        using Output = detail::WhenAllResult<ErrorType, OkTypes...>;
+        std::array<detail::ChildRef, sizeof...(OkTypes)> children {detail::TaskAccess::child(tasks)...};
+        detail::Join<detail::JoinMode::All> join(children);
+        detail::JoinOutcome outcome = co_await join.wait();
+        if (outcome.first_failure) {
+            std::optional<Output> failure;
+            auto take_failure = [&](auto& task) {
+                if (detail::TaskAccess::child(task).promise == outcome.first_failure) {
+                    failure.emplace(in_place_error, detail::TaskAccess::take(task).error_unchecked());
+                }
+            };
+            (take_failure(tasks), ...);
+            co_return std::move(*failure);
+        }
+        if (outcome.cancelled) {
+            // Only a stop from an enclosing join cancels children without a failure; end this task too.
+            co_await cancellation_point();
+        }
+        if constexpr (std::is_void_v<typename Output::value_type>) {
+            (detail::take_value(tasks), ...);
+            co_return Output(in_place_ok);
+        } else {
+            co_return Output(in_place_ok, detail::take_value(tasks)...);
+        }
+    }
+
+    // The same over a vector of tasks, completing with their values in order, or with Result<void, E>
+    // for Result<void> tasks.
+    template <typename OkType, typename ErrorType>
+    Task<detail::WhenAllVectorResult<ErrorType, OkType>> when_all(std::vector<Task<Result<OkType, ErrorType>>> tasks) {
+        using Output = detail::WhenAllVectorResult<ErrorType, OkType>;
+        std::vector<detail::ChildRef> children = detail::children_of(tasks);
+        detail::Join<detail::JoinMode::All> join(children);
+        detail::JoinOutcome outcome = co_await join.wait();
+        if (!outcome.first_failure && outcome.cancelled) {
+            co_await cancellation_point();
+        }
+        std::vector<detail::JoinSlot<OkType>> values;
+        if constexpr (!std::is_void_v<OkType>) {
+            values.reserve(tasks.size());
+        }
+        for (Task<Result<OkType, ErrorType>>& task : tasks) {
+            if (outcome.first_failure == detail::TaskAccess::child(task).promise) {
+                co_return Output(in_place_error, detail::TaskAccess::take(task).error_unchecked());
+            }
+            if (!outcome.first_failure) {
+                if constexpr (std::is_void_v<OkType>) {
+                    detail::take_value(task);
+                } else {
+                    values.push_back(detail::take_value(task));
+                }
+            }
+        }
+        if constexpr (std::is_void_v<OkType>) {
+            co_return Output(in_place_ok);
+        } else {
+            co_return Output(in_place_ok, std::move(values));
+        }
+    }
+
+    // Runs the tasks concurrently and completes with the value of the first task to succeed,
+    // cancelling the others. If every task fails, completes with the error of the first failure.
+    // There must be at least one task: awaiting when_any() of an empty vector throws
+    // std::invalid_argument (calls panic() under RESULT_NO_EXCEPTIONS).
+    template <typename OkType, typename ErrorType>
+    Task<Result<OkType, ErrorType>> when_any(std::vector<Task<Result<OkType, ErrorType>>> tasks) {
+        if (tasks.empty()) {
+            detail::no_tasks("when_any() needs at least one task");
+        }
+        std::vector<detail::ChildRef> children = detail::children_of(tasks);
+        detail::Join<detail::JoinMode::Any> join(children);
+        detail::JoinOutcome outcome = co_await join.wait();
+        if (!outcome.first_success && outcome.cancelled) {
+            co_await cancellation_point();
+        }
+        detail::TaskPromiseBase* decider = outcome.first_success ? outcome.first_success : outcome.first_failure;
+        for (Task<Result<OkType, ErrorType>>& task : tasks) {
+            if (detail::TaskAccess::child(task).promise == decider) {
+                co_return detail::TaskAccess::take(task);
+            }
+        }
+        detail::panic("when_any() completed without a result");
+    }
+}
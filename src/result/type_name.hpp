@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace result::detail {
+    // Name of T as spelled by the compiler, for diagnostics.
+    template <typename T>
+    constexpr std::string_view type_name() noexcept {
+#if defined(__clang__) || defined(__GNUC__)
+        std::string_view signature = __PRETTY_FUNCTION__;
+        std::size_t begin = signature.find("T = ");
+        if (begin == std::string_view::npos) {
+            return "unknown";
+        }
+        begin += 4;
+        std::size_t end = signature.find_first_of(";]", begin);
+        return signature.substr(begin, end - begin);
+#elif defined(_MSC_VER)
+        std::string_view signature = __FUNCSIG__;
+        std::size_t begin = signature.find("type_name<") + 10;
+        std::size_t end = signature.rfind(">(void)");
+        return signature.substr(begin, end - begin);
+#else
+        return "unknown";
+#endif
+    }
+
+    // 64-bit FNV-1a hash of type_name<T>(), stable across builds with the same compiler.
+    template <typename T>
+    constexpr std::uint64_t type_hash() noexcept {
+        std::uint64_t hash = 0xcbf29ce484222325u;
+        for (char c : type_name<T>()) {
+            hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001b3u;
+        }
+        return hash;
+    }
+
+    template <typename T>
+    constexpr inline std::uint64_t type_hash_v = type_hash<T>();
+}
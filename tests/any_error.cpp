@@ -0,0 +1,165 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <result/any_error.hpp>
+#include <string>
+#include <string_view>
+
+using namespace result;
+
+namespace {
+    enum class IoError : std::uint8_t { NotFound, PermissionDenied };
+
+    enum class ParseError { Empty, Garbage };
+
+    struct Located {
+        std::string_view message;
+        int line;
+
+        bool operator==(const Located&) const = default;
+    };
+
+    // No operator==: equal only to itself.
+    struct Opaque {
+        std::string detail;
+    };
+}
+
+template <>
+struct result::ErrorDescription<IoError> {
+    static std::string_view description(IoError error) noexcept {
+        return error == IoError::NotFound ? "file not found" : "permission denied";
+    }
+};
+
+template <>
+struct result::ErrorDescription<Located> {
+    static std::string_view description(const Located& error) noexcept { return error.message; }
+};
+
+static_assert(sizeof(AnyError) == 2 * sizeof(void*));
+static_assert(sizeof(Result<int, AnyError>) == 2 * sizeof(void*));
+static_assert(sizeof(Result<void, AnyError>) == 2 * sizeof(void*));
+static_assert(sizeof(Result<const char*, AnyError>) == 2 * sizeof(void*));
+static_assert(AnyError::stores_inline<IoError> && AnyError::stores_inline<const char*>);
+static_assert(!AnyError::stores_inline<Located> && !AnyError::stores_inline<std::string>);
+
+namespace {
+    Result<int, AnyError> open_file(std::string_view path) {
+        if (path.empty()) {
+            return Error<AnyError> {ParseError::Empty};
+        }
+        if (path == "missing") {
+            return Error<AnyError> {IoError::NotFound};
+        }
+        if (path == "locked") {
+            return Error<AnyError> {Located {"locked by another process", 12}};
+        }
+        return Ok {static_cast<int>(path.size())};
+    }
+}
+
+TEST_CASE("AnyError", "[AnyError]") {
+    SECTION("Inline and heap payloads keep their type") {
+        AnyError code = IoError::PermissionDenied;
+        REQUIRE(code.is<IoError>());
+        REQUIRE_FALSE(code.is<ParseError>());
+        REQUIRE(*code.get_if<IoError>() == IoError::PermissionDenied);
+        REQUIRE(code.get_if<Located>() == nullptr);
+
+        AnyError located = Located {"bad token", 3};
+        REQUIRE(located.get_if<Located>()->line == 3);
+
+        AnyError text(std::in_place_type<std::string>, 3, 'x');
+        REQUIRE(*text.get_if<std::string>() == "xxx");
+    }
+
+    SECTION("Descriptions come from ErrorDescription or string payloads") {
+        REQUIRE(AnyError(IoError::NotFound).description() == "file not found");
+        REQUIRE(AnyError(Located {"bad token", 3}).description() == "bad token");
+        REQUIRE(AnyError("static message").description() == "static message");
+        REQUIRE(AnyError(std::string("owned message")).description() == "owned message");
+        REQUIRE(AnyError(ParseError::Garbage).description() == "unknown error");
+    }
+
+    SECTION("Comparison") {
+        REQUIRE(AnyError(IoError::NotFound) == AnyError(IoError::NotFound));
+        REQUIRE(AnyError(IoError::NotFound) != AnyError(IoError::PermissionDenied));
+        REQUIRE(AnyError(IoError::NotFound) != AnyError(ParseError::Empty));
+        REQUIRE(AnyError(Located {"a", 1}) == Located {"a", 1});
+        REQUIRE(AnyError(IoError::NotFound) == IoError::NotFound);
+        REQUIRE(AnyError(IoError::NotFound) != ParseError::Empty);
+
+        AnyError opaque = Opaque {"x"};
+        AnyError copy = opaque;
+        REQUIRE(opaque == opaque);
+        REQUIRE(opaque != copy);
+    }
+
+    SECTION("Copies and moves") {
+        AnyError original = Located {"copied", 7};
+        AnyError copy = original;
+        REQUIRE(copy == original);
+        REQUIRE(copy.get_if<Located>() != original.get_if<Located>());
+
+        AnyError moved = std::move(original);
+        REQUIRE(moved.get_if<Located>()->line == 7);
+        REQUIRE(original.description() == "moved-from error");
+
+        original = moved;
+        REQUIRE(original == moved);
+        moved = IoError::NotFound;
+        REQUIRE(moved == IoError::NotFound);
+        copy = std::move(moved);
+        REQUIRE(copy == IoError::NotFound);
+    }
+}
+
+TEST_CASE("Results with AnyError", "[AnyError]") {
+    SECTION("Ok and error alternatives") {
+        REQUIRE(open_file("data.bin").unwrap() == 8);
+        REQUIRE(open_file("missing").error() == IoError::NotFound);
+        REQUIRE(open_file("locked").error().get_if<Located>()->line == 12);
+        REQUIRE(open_file("").error() == ParseError::Empty);
+    }
+
+    SECTION("Switching alternatives") {
+        Result<int, AnyError> result = open_file("missing");
+        result = open_file("file");
+        REQUIRE(result.unwrap() == 4);
+        result = open_file("locked");
+        REQUIRE(result.error().description() == "locked by another process");
+
+        Result<int, AnyError> copy = result;
+        REQUIRE(copy.error() == result.error());
+        copy = Ok {5};
+        REQUIRE(copy.unwrap() == 5);
+    }
+
+    SECTION("Moving the error out leaves an error behind") {
+        Result<int, AnyError> result = open_file("locked");
+        AnyError error = std::move(result).error();
+        REQUIRE(result.has_error());
+        REQUIRE(error.description() == "locked by another process");
+    }
+
+    SECTION("Void results") {
+        Result<void, AnyError> ok = Ok<> {};
+        Result<void, AnyError> failed = Error<AnyError> {IoError::PermissionDenied};
+        REQUIRE_FALSE(ok.has_error());
+        REQUIRE(failed.error().description() == "permission denied");
+    }
+
+    SECTION("Combinators and unwrap messages") {
+        auto doubled = open_file("four").map([](int value) { return value * 2; });
+        REQUIRE(doubled.unwrap() == 8);
+        auto described = open_file("missing").map_error([](const AnyError& error) { return std::string(error.description()); });
+        REQUIRE(described.error() == "file not found");
+
+        try {
+            (void)open_file("missing").unwrap();
+            FAIL("unwrap() did not throw");
+        } catch (const std::exception& exception) {
+            REQUIRE(std::string_view(exception.what()) == "Failed to unwrap Result: file not found");
+        }
+    }
+}
@@ -0,0 +1,110 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <result/batch.hpp>
+#include <result/result_vector.hpp>
+#include <span>
+#include <vector>
+
+using namespace result;
+
+namespace {
+    enum class SensorError : std::uint8_t { OutOfRange, Disconnected };
+
+    template <typename T>
+    std::vector<Result<T, SensorError>> make_readings(std::size_t size) {
+        std::vector<Result<T, SensorError>> readings;
+        for (std::size_t i = 0; i < size; ++i) {
+            if (i % 3 == 0 || i % 7 == 5) {
+                readings.emplace_back(Error<SensorError> {SensorError::OutOfRange});
+            } else {
+                readings.emplace_back(Ok<T> {static_cast<T>(i)});
+            }
+        }
+        return readings;
+    }
+
+    // Instruction sets the CPU lacks are requested too: the kernels must lower them to one it has.
+    constexpr batch::Isa AllIsas[] = {batch::Isa::Scalar, batch::Isa::Sse2, batch::Isa::Avx2, batch::Isa::Avx512};
+
+    template <typename T>
+    void check_kernels(std::size_t size) {
+        auto readings = make_readings<T>(size);
+        std::vector<T> values(size);
+        std::vector<std::uint64_t> status(batch::word_count(size));
+        auto view = batch::split(readings, std::span<T>(values), std::span<std::uint64_t>(status));
+
+        std::size_t errors = batch::count_errors(readings);
+        std::vector<T> expected_unwrapped(size);
+        batch::unwrap_or(readings, T {42}, std::span<T>(expected_unwrapped));
+        batch::Partition expected_partition = batch::partition(readings);
+        REQUIRE(expected_partition.oks.size() + expected_partition.errors.size() == size);
+        REQUIRE(expected_partition.errors.size() == errors);
+
+        for (batch::Isa isa : AllIsas) {
+            REQUIRE(batch::count_errors(view, isa) == errors);
+
+            std::vector<T> unwrapped(size, T {7});
+            batch::unwrap_or(view, T {42}, std::span<T>(unwrapped), isa);
+            REQUIRE(unwrapped == expected_unwrapped);
+
+            std::vector<T> doubled(size);
+            auto mapped = batch::map(view, [](T x) { return static_cast<T>(x * 2 + 1); }, std::span<T>(doubled), isa);
+            REQUIRE(mapped.status.data() == view.status.data());
+            for (std::size_t index : expected_partition.oks) {
+                REQUIRE(doubled[index] == static_cast<T>(readings[index].unwrap() * 2 + 1));
+            }
+
+            batch::Partition partition = batch::partition(view, isa);
+            REQUIRE(partition.oks == expected_partition.oks);
+            REQUIRE(partition.errors == expected_partition.errors);
+        }
+    }
+}
+
+TEST_CASE("Batch kernels", "[Batch]") {
+    SECTION("Split records one status bit per lane") {
+        auto readings = make_readings<int>(70);
+        std::vector<int> values(70, -1);
+        std::vector<std::uint64_t> status(2);
+        auto view = batch::split(readings, std::span<int>(values), std::span<std::uint64_t>(status));
+
+        REQUIRE(view.size() == 70);
+        REQUIRE((status[0] & 1) == 0);
+        REQUIRE((status[0] >> 1 & 1) == 1);
+        REQUIRE(status[1] >> 6 == 0);
+        REQUIRE(values[0] == 0);
+        REQUIRE(values[1] == 1);
+    }
+
+    SECTION("Every instruction set agrees with the per-element loop") {
+        for (std::size_t size : {0, 1, 15, 64, 65, 200, 1031}) {
+            check_kernels<int>(size);
+            check_kernels<float>(size);
+            check_kernels<double>(size);
+            check_kernels<std::uint16_t>(size);
+        }
+    }
+
+    SECTION("Map converts between lane types") {
+        auto readings = make_readings<std::int32_t>(100);
+        std::vector<std::int32_t> values(100);
+        std::vector<std::uint64_t> status(2);
+        auto view = batch::split(readings, std::span<std::int32_t>(values), std::span<std::uint64_t>(status));
+
+        std::vector<double> scaled(100);
+        auto mapped = batch::map(view, [](std::int32_t x) { return x * 0.5; }, std::span<double>(scaled));
+        REQUIRE(scaled[4] == 2.0);
+        REQUIRE(batch::count_errors(mapped) == batch::count_errors(view));
+    }
+
+    SECTION("ResultVector status words are a batch bitmap") {
+        ResultVector<int, SensorError> results(make_readings<int>(130));
+        REQUIRE(batch::count_errors(results.status_words(), results.size()) == results.error_count());
+
+        batch::Partition partition = batch::partition(results.status_words(), results.size());
+        REQUIRE(partition.oks.size() == results.ok_count());
+        for (std::size_t i = 0; i < results.errors().size(); ++i) {
+            REQUIRE(partition.errors[i] == results.errors()[i].index);
+        }
+    }
+}
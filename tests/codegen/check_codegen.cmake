@@ -0,0 +1,79 @@
+# Usage: cmake -DOBJDUMP=<objdump> -DOBJECT=<kernels object file> [-DKERNELS=<names>] -P check_codegen.cmake
+#
+# For every kernels::result_<name> function, checks that the disassembly calls none of the
+# throwing or allocating helpers a zero-overhead Result must not need, and that its instruction
+# count stays within tolerance of kernels::handwritten_<name>. Calls in an object file are
+# unresolved, so the helpers are found by the relocations objdump -r prints, and the parts of a
+# function the compiler moved into a [clone .cold] body count as part of that function.
+
+if(NOT DEFINED KERNELS)
+    set(KERNELS map map_chain unwrap_or sum try and_then packed_map packed_unwrap_or)
+endif()
+set(FORBIDDEN __cxa_throw __cxa_allocate_exception BadUnwrapException runtime_error basic_string variant
+    result::detail::bad_unwrap result::detail::bad_error_access result::detail::output_too_small result::detail::panic)
+set(TOLERANCE_PERCENT 10)
+set(TOLERANCE_SLACK 2)
+
+execute_process(
+    COMMAND ${OBJDUMP} -d -r -C --no-show-raw-insn ${OBJECT}
+    OUTPUT_VARIABLE disassembly
+    RESULT_VARIABLE objdump_result
+)
+if(NOT objdump_result EQUAL 0)
+    message(FATAL_ERROR "objdump failed on ${OBJECT}")
+endif()
+
+# Split the disassembly into one entry per function, keyed by name without the parameter list, so
+# that a [clone .cold] body is appended to its parent's. Relocation lines go into the body but are
+# not counted as instructions.
+string(REPLACE ";" "\;" disassembly "${disassembly}")
+string(REPLACE "\n" ";" lines "${disassembly}")
+set(current "")
+foreach(line IN LISTS lines)
+    if(line MATCHES "^[0-9a-f]+ <(.*)>:$")
+        set(current "${CMAKE_MATCH_1}")
+        string(REGEX REPLACE "\\(.*" "" current "${current}")
+        if(NOT DEFINED count_${current})
+            set(body_${current} "")
+            set(count_${current} 0)
+        endif()
+    elseif(current AND line MATCHES "^\t+[0-9a-f]+: R_")
+        string(APPEND body_${current} "${line}\n")
+    elseif(current AND line MATCHES "^ +[0-9a-f]+:\t" AND NOT line MATCHES "\t(nop|xchg +%ax,%ax)")
+        string(APPEND body_${current} "${line}\n")
+        math(EXPR count_${current} "${count_${current}} + 1")
+    endif()
+endforeach()
+
+set(failures 0)
+foreach(kernel IN LISTS KERNELS)
+    set(result_name "kernels::result_${kernel}")
+    set(handwritten_name "kernels::handwritten_${kernel}")
+    if(NOT DEFINED count_${result_name} OR NOT DEFINED count_${handwritten_name})
+        message(SEND_ERROR "${kernel}: kernel pair not found in ${OBJECT}")
+        math(EXPR failures "${failures} + 1")
+        continue()
+    endif()
+
+    foreach(symbol IN LISTS FORBIDDEN)
+        string(FIND "${body_${result_name}}" "${symbol}" position)
+        if(NOT position EQUAL -1)
+            message(SEND_ERROR "${kernel}: result kernel references ${symbol}")
+            math(EXPR failures "${failures} + 1")
+        endif()
+    endforeach()
+
+    set(result_count ${count_${result_name}})
+    set(handwritten_count ${count_${handwritten_name}})
+    math(EXPR limit "${handwritten_count} * (100 + ${TOLERANCE_PERCENT}) / 100 + ${TOLERANCE_SLACK}")
+    if(result_count GREATER limit)
+        message(SEND_ERROR "${kernel}: ${result_count} instructions, handwritten has ${handwritten_count} (limit ${limit})")
+        math(EXPR failures "${failures} + 1")
+    else()
+        message(STATUS "${kernel}: ${result_count} instructions, handwritten has ${handwritten_count}")
+    endif()
+endforeach()
+
+if(failures GREATER 0)
+    message(FATAL_ERROR "${failures} codegen check(s) failed")
+endif()
@@ -0,0 +1,152 @@
+// Kernels for the codegen regression test. Every result_* function has a handwritten_*
+// counterpart that implements the same logic with a plain struct and explicit branches;
+// check_codegen.cmake disassembles this file and compares each pair.
+#include <cstddef>
+#include <cstdint>
+#include <result/packed_result.hpp>
+#include <result/result.hpp>
+
+using namespace result;
+
+namespace kernels {
+    enum class Code : std::uint8_t { Invalid, Overflow };
+
+    using IntResult = Result<int, Code>;
+
+    // Same layout as Result<int, Code>.
+    struct Handwritten {
+        constexpr Handwritten(int v) : value(v), ok(true) {}
+        constexpr Handwritten(Code e) : error(e), ok(false) {}
+
+        union {
+            int value;
+            Code error;
+        };
+        bool ok;
+    };
+
+    IntResult result_map(const IntResult& r) {
+        return r.map([](int x) { return x * 2 + 1; });
+    }
+
+    Handwritten handwritten_map(const Handwritten& r) {
+        if (!r.ok) {
+            return Handwritten(r.error);
+        }
+        return Handwritten(r.value * 2 + 1);
+    }
+
+    Result<int, int> result_map_chain(const IntResult& r) {
+        return r.map([](int x) { return x * 3; })
+            .map([](int x) { return x + 7; })
+            .map_error([](Code code) { return static_cast<int>(code) + 100; });
+    }
+
+    struct HandwrittenIntError {
+        constexpr HandwrittenIntError(int v, bool is_ok) : value(v), ok(is_ok) {}
+
+        int value;
+        bool ok;
+    };
+
+    HandwrittenIntError handwritten_map_chain(const Handwritten& r) {
+        if (!r.ok) {
+            return HandwrittenIntError(static_cast<int>(r.error) + 100, false);
+        }
+        return HandwrittenIntError(r.value * 3 + 7, true);
+    }
+
+    int result_unwrap_or(const IntResult& r) {
+#ifdef KERNELS_CHECKED_UNWRAP
+        // For the negative self-test: unwrap() without testing the Result first keeps its failure
+        // path, which the check must reject.
+        return r.unwrap();
+#else
+        return r ? r.unwrap() : -1;
+#endif
+    }
+
+    int handwritten_unwrap_or(const Handwritten& r) {
+        return r.ok ? r.value : -1;
+    }
+
+    int result_sum(const IntResult* results, std::size_t count) {
+        int sum = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            if (results[i].has_value()) {
+                sum += results[i].unwrap();
+            }
+        }
+        return sum;
+    }
+
+    int handwritten_sum(const Handwritten* results, std::size_t count) {
+        int sum = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            if (results[i].ok) {
+                sum += results[i].value;
+            }
+        }
+        return sum;
+    }
+
+    IntResult result_try(const IntResult& a, const IntResult& b) {
+        RESULT_TRY(int x, a);
+        RESULT_TRY(int y, b);
+        return Ok<int> {x + y};
+    }
+
+    Handwritten handwritten_try(const Handwritten& a, const Handwritten& b) {
+        if (!a.ok) {
+            return Handwritten(a.error);
+        }
+        if (!b.ok) {
+            return Handwritten(b.error);
+        }
+        return Handwritten(a.value + b.value);
+    }
+
+    IntResult result_and_then(const IntResult& r) {
+        return r.and_then([](int x) -> IntResult {
+            if (x < 0) {
+                return Error<Code> {Code::Overflow};
+            }
+            return Ok<int> {x / 2};
+        });
+    }
+
+    Handwritten handwritten_and_then(const Handwritten& r) {
+        if (!r.ok) {
+            return Handwritten(r.error);
+        }
+        if (r.value < 0) {
+            return Handwritten(Code::Overflow);
+        }
+        return Handwritten(r.value / 2);
+    }
+
+    using PackedIntResult = PackedResult<std::uint32_t, Code>;
+
+    // Same encoding as PackedResult<std::uint32_t, Code>: the payload in the low bits, bit 63 set
+    // when it is the Ok value.
+    constexpr std::uint64_t HandwrittenOkBit = std::uint64_t {1} << 63;
+
+    PackedIntResult result_packed_map(PackedIntResult r) {
+        return r.map([](std::uint32_t x) { return x * 2 + 1; });
+    }
+
+    std::uint64_t handwritten_packed_map(std::uint64_t r) {
+        if ((r & HandwrittenOkBit) == 0) {
+            return r;
+        }
+        return HandwrittenOkBit | (static_cast<std::uint32_t>(r) * 2 + 1);
+    }
+
+    std::uint32_t result_packed_unwrap_or(PackedIntResult r) {
+        return r ? *r : 0;
+    }
+
+    std::uint32_t handwritten_packed_unwrap_or(std::uint64_t r) {
+        return (r & HandwrittenOkBit) != 0 ? static_cast<std::uint32_t>(r) : 0;
+    }
+}
@@ -0,0 +1,88 @@
+#include <catch2/catch_test_macros.hpp>
+#include <result/coroutine.hpp>
+#include <string>
+
+using namespace result;
+
+namespace {
+    Result<int, std::string> parse_number(const std::string& text) {
+        if (text.empty() || text.find_first_not_of("0123456789") != std::string::npos) {
+            return Error<std::string> {"not a number: " + text};
+        }
+        return Ok<int> {std::stoi(text)};
+    }
+
+    Result<void, std::string> check_positive(int value) {
+        if (value <= 0) {
+            return Error<std::string> {"not positive"};
+        }
+        return Ok<> {};
+    }
+
+    int steps = 0;
+
+    Result<int, std::string> sum(const std::string& a, const std::string& b) {
+        int x = co_await parse_number(a);
+        ++steps;
+        int y = co_await parse_number(b);
+        ++steps;
+        co_await check_positive(x + y);
+        ++steps;
+        co_return Ok<int> {x + y};
+    }
+
+    Result<void, std::string> validate(const std::string& text) {
+        Result<int, std::string> parsed = parse_number(text);
+        int value = co_await parsed;
+        co_await check_positive(value);
+        co_return Ok<> {};
+    }
+
+    Result<std::string, std::string> describe(const std::string& text) {
+        if (text == "early") {
+            co_return Error<std::string> {"early exit"};
+        }
+        int value = co_await parse_number(text);
+        co_return Ok<std::string> {std::to_string(value * 2)};
+    }
+}
+
+TEST_CASE("Coroutine Result", "[Coroutine]") {
+    SECTION("All awaited Results are Ok") {
+        steps = 0;
+        auto result = sum("2", "40");
+        REQUIRE(result.unwrap() == 42);
+        REQUIRE(steps == 3);
+    }
+
+    SECTION("First error short-circuits the coroutine") {
+        steps = 0;
+        auto result = sum("2", "x");
+        REQUIRE(result.error() == "not a number: x");
+        REQUIRE(steps == 1);
+    }
+
+    SECTION("Awaiting a void Result") {
+        steps = 0;
+        auto result = sum("0", "0");
+        REQUIRE(result.error() == "not positive");
+        REQUIRE(steps == 2);
+    }
+
+    SECTION("Void coroutine awaiting an lvalue") {
+        REQUIRE(!validate("5").has_error());
+        REQUIRE(validate("0").error() == "not positive");
+        REQUIRE(validate("-").error() == "not a number: -");
+    }
+
+    SECTION("Explicit error return") {
+        REQUIRE(describe("21").unwrap() == "42");
+        REQUIRE(describe("early").error() == "early exit");
+    }
+
+    SECTION("Repeated calls reuse coroutine frames") {
+        for (int i = 0; i < 1000; ++i) {
+            REQUIRE(sum("1", std::to_string(i)).unwrap() == i + 1);
+        }
+    }
+}
@@ -1,5 +1,9 @@
 #include <catch2/catch_test_macros.hpp>
+#include <memory>
 #include <result/result.hpp>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 using namespace result;
 
@@ -64,6 +68,77 @@ TEST_CASE("Unwrap Method", "[Result]") {
     }
 }
 
+namespace {
+    struct CountedError {
+        static inline int copies = 0;
+        static inline int moves = 0;
+
+        explicit CountedError(std::string text) : text(std::move(text)) {}
+        CountedError(const CountedError& other) : text(other.text) { ++copies; }
+        CountedError(CountedError&& other) noexcept : text(std::move(other.text)) { ++moves; }
+
+        std::string text;
+    };
+}
+
+template <>
+struct result::ErrorDescription<CountedError> {
+    static std::string_view description(const CountedError& error) noexcept { return error.text; }
+};
+
+TEST_CASE("BadUnwrapException", "[Result]") {
+    Result<int, CountedError> result_error(Error<CountedError> {CountedError("disk full")});
+    CountedError::copies = 0;
+    CountedError::moves = 0;
+
+    SECTION("Unwrapping an lvalue copies the error once") {
+        try {
+            (void)result_error.unwrap();
+            FAIL("unwrap() did not throw");
+        } catch (const BadUnwrapException<CountedError>& exception) {
+            REQUIRE(CountedError::copies == 1);
+            REQUIRE(exception.error().text == "disk full");
+            REQUIRE(std::string_view(exception.what()) == "Failed to unwrap Result: disk full");
+            REQUIRE(exception.what() == exception.what());
+        }
+    }
+
+    SECTION("Unwrapping an rvalue moves the error") {
+        try {
+            (void)std::move(result_error).unwrap();
+            FAIL("unwrap() did not throw");
+        } catch (const BadUnwrapException<CountedError>& exception) {
+            REQUIRE(CountedError::copies == 0);
+            REQUIRE(exception.error().text == "disk full");
+        }
+    }
+
+    SECTION("Copies format their own message") {
+        BadUnwrapException<CountedError> original(CountedError("copied"));
+        BadUnwrapException<CountedError> copy = original;
+        REQUIRE(std::string_view(original.what()) == "Failed to unwrap Result: copied");
+        REQUIRE(std::string_view(copy.what()) == "Failed to unwrap Result: copied");
+        REQUIRE(copy.what() != original.what());
+    }
+
+    SECTION("Long descriptions are truncated") {
+        BadUnwrapException<CountedError> exception(CountedError(std::string(1000, 'x')));
+        std::string_view message = exception.what();
+        REQUIRE(message.size() == detail::BadUnwrapMessageCapacity - 1);
+        REQUIRE(message.starts_with("Failed to unwrap Result: xxx"));
+    }
+
+    SECTION("Errors without a description") {
+        Result<int, int> result(Error {3});
+        try {
+            (void)result.unwrap();
+            FAIL("unwrap() did not throw");
+        } catch (const std::exception& exception) {
+            REQUIRE(std::string_view(exception.what()) == "Failed to unwrap Result");
+        }
+    }
+}
+
 TEST_CASE("Error Method", "[Result]") {
     SECTION("Error for error result") {
         Result<int, std::string> result_error(Error<std::string> {"Error occurred"});
@@ -315,3 +390,785 @@ TEST_CASE("Deeply nested Result", "[Result]") {
         REQUIRE(result.unwrap().error() == "Middle error");
     }
 }
+
+enum class ParseError { InvalidDigit, Overflow };
+
+TEST_CASE("Tagged union storage", "[Result]") {
+    SECTION("Trivial payloads keep Result trivial") {
+        using TrivialResult = Result<int, ParseError>;
+        STATIC_REQUIRE(std::is_trivially_copyable_v<TrivialResult>);
+        STATIC_REQUIRE(std::is_trivially_destructible_v<TrivialResult>);
+        STATIC_REQUIRE(sizeof(TrivialResult) == 2 * sizeof(int));
+    }
+
+    SECTION("Non-trivial payloads are not trivially copyable") {
+        STATIC_REQUIRE(!std::is_trivially_copyable_v<Result<int, std::string>>);
+        STATIC_REQUIRE(!std::is_trivially_destructible_v<Result<std::string, int>>);
+    }
+
+    SECTION("Assignment switches between alternatives") {
+        Result<std::string, std::string> result(Ok<std::string> {"value"});
+        result = Error<std::string> {"error"};
+        REQUIRE(result.has_error());
+        REQUIRE(result.error() == "error");
+
+        result = Ok<std::string> {"other value"};
+        REQUIRE(result.has_value());
+        REQUIRE(result.unwrap() == "other value");
+
+        Result<std::string, std::string> error_result(Error<std::string> {"copied error"});
+        result = error_result;
+        REQUIRE(result.error() == "copied error");
+
+        result = Result<std::string, std::string>(Ok<std::string> {"moved value"});
+        REQUIRE(result.unwrap() == "moved value");
+    }
+}
+
+// Pre-C++11 style: a user-provided copy constructor and no noexcept move, so every way of
+// constructing it may throw.
+struct Legacy {
+    static inline bool fail_copies = false;
+
+    int value;
+
+    explicit Legacy(int v) : value(v) {
+        if (v < 0) {
+            throw std::invalid_argument("negative");
+        }
+    }
+    Legacy(const Legacy& other) : value(other.value) {
+        if (fail_copies) {
+            throw std::runtime_error("copy failed");
+        }
+    }
+    Legacy& operator=(const Legacy&) = default;
+};
+
+TEST_CASE("Reassignment with throwing payloads", "[Result]") {
+    STATIC_REQUIRE_FALSE(std::is_nothrow_move_constructible_v<Legacy>);
+
+    SECTION("Assignment and emplace compile and work") {
+        Result<Legacy, int> result(Error<int> {1});
+        result = Ok<Legacy> {Legacy(2)};
+        REQUIRE(result.unwrap().value == 2);
+
+        Result<Legacy, int> copy(Error<int> {3});
+        copy = result;
+        REQUIRE(copy.unwrap().value == 2);
+
+        copy.emplace_ok(4);
+        REQUIRE(copy.unwrap().value == 4);
+        copy.emplace_error(5);
+        REQUIRE(copy.error() == 5);
+    }
+
+    SECTION("Throwing construction restores the previous error") {
+        Result<Legacy, int> result(Error<int> {7});
+        REQUIRE_THROWS_AS(result.emplace_ok(-1), std::invalid_argument);
+        REQUIRE(result.has_error());
+        REQUIRE(result.error() == 7);
+
+        Legacy::fail_copies = true;
+        const Result<Legacy, int> source(in_place_ok, 8);
+        REQUIRE_THROWS_AS(result = source, std::runtime_error);
+        Legacy::fail_copies = false;
+        REQUIRE(result.error() == 7);
+    }
+
+    SECTION("Throwing construction keeps the previous value") {
+        Result<Legacy, int> result(in_place_ok, 9);
+        REQUIRE_THROWS_AS(result.emplace_ok(-1), std::invalid_argument);
+        REQUIRE(result.unwrap().value == 9);
+    }
+}
+
+enum class IoError : std::uint8_t { NotFound, PermissionDenied };
+
+template <>
+struct result::NicheTraits<IoError> {
+    static constexpr IoError niche() noexcept { return static_cast<IoError>(0xff); }
+    static constexpr bool is_niche(IoError error) noexcept { return error == niche(); }
+};
+
+struct FileHandle {
+    int fd;
+};
+
+template <>
+struct result::NicheTraits<FileHandle> {
+    static constexpr FileHandle niche() noexcept { return FileHandle{-1}; }
+    static constexpr bool is_niche(const FileHandle& handle) noexcept { return handle.fd == -1; }
+};
+
+template <>
+struct result::PointerNiche<FileHandle> : std::true_type {};
+
+TEST_CASE("Niche optimization", "[Result]") {
+    SECTION("Void specialization stores the tag in the error niche") {
+        STATIC_REQUIRE(sizeof(Result<void, IoError>) == sizeof(IoError));
+        STATIC_REQUIRE(std::is_trivially_copyable_v<Result<void, IoError>>);
+
+        Result<void, IoError> result(Ok<> {});
+        REQUIRE(!result.has_error());
+        REQUIRE_NOTHROW(result.unwrap());
+
+        result = Error<IoError> {IoError::PermissionDenied};
+        REQUIRE(result.has_error());
+        REQUIRE(result.error() == IoError::PermissionDenied);
+
+        result = Ok<> {};
+        REQUIRE(!result.has_error());
+    }
+
+    SECTION("Ok payload niche with an empty error type") {
+        using HandleResult = Result<FileHandle, EmptyType>;
+        STATIC_REQUIRE(sizeof(HandleResult) == sizeof(FileHandle));
+
+        HandleResult result(Ok<FileHandle> {FileHandle{3}});
+        REQUIRE(result.has_value());
+        REQUIRE(result.unwrap().fd == 3);
+
+        result = Error<EmptyType> {EmptyType{}};
+        REQUIRE(result.has_error());
+        REQUIRE_THROWS(result.unwrap());
+    }
+
+    SECTION("Pointers keep an enum error in their alignment bit") {
+        using Lookup = Result<const FileHandle*, IoError>;
+        STATIC_REQUIRE(sizeof(Lookup) == sizeof(void*));
+        STATIC_REQUIRE(std::is_trivially_copyable_v<Lookup>);
+
+        const FileHandle handles[] = {FileHandle{3}, FileHandle{4}};
+        Lookup result(Ok<const FileHandle*> {&handles[1]});
+        REQUIRE(result.has_value());
+        REQUIRE(result.unwrap()->fd == 4);
+
+        result = Error<IoError> {IoError::PermissionDenied};
+        REQUIRE(result.has_error());
+        REQUIRE(result.error() == IoError::PermissionDenied);
+        REQUIRE_THROWS(result.unwrap());
+
+        result.emplace_error(IoError::NotFound);
+        REQUIRE(result.error() == IoError::NotFound);
+
+        result = Ok<const FileHandle*> {nullptr};
+        REQUIRE(result.has_value());
+        REQUIRE(result.unwrap() == nullptr);
+
+        Lookup copy = result.map([&](const FileHandle*) { return &handles[0]; });
+        REQUIRE(copy.unwrap()->fd == 3);
+    }
+
+    SECTION("Types without a niche keep a separate tag") {
+        STATIC_REQUIRE(sizeof(Result<void, ParseError>) > sizeof(ParseError));
+        STATIC_REQUIRE(sizeof(Result<const int*, IoError>) > sizeof(void*));
+    }
+
+    SECTION("Niche storage is usable in constant expressions") {
+        constexpr Result<void, IoError> result(Error<IoError> {IoError::NotFound});
+        STATIC_REQUIRE(result.has_error());
+        STATIC_REQUIRE(result.error() == IoError::NotFound);
+    }
+}
+
+// Large enough that keeping it inline would dominate the size of any Result.
+struct Diagnostic {
+    char message[112] {};
+    int line = 0;
+    int column = 0;
+};
+
+template <>
+struct result::BoxError<Diagnostic> : std::true_type {};
+
+constexpr Result<int, Diagnostic> diagnose(int line) {
+    if (line == 0) {
+        return Ok {42};
+    }
+    Diagnostic diagnostic;
+    diagnostic.line = line;
+    return Error {diagnostic};
+}
+
+TEST_CASE("Boxed errors", "[Result]") {
+    SECTION("The error is kept out of line") {
+        STATIC_REQUIRE(sizeof(Diagnostic) == 120);
+        STATIC_REQUIRE(sizeof(Result<int, Diagnostic>) == 2 * sizeof(void*));
+        STATIC_REQUIRE(sizeof(Result<void, Diagnostic>) == 2 * sizeof(void*));
+        STATIC_REQUIRE(std::is_nothrow_move_constructible_v<Result<int, Diagnostic>>);
+    }
+
+    SECTION("Ok and error alternatives") {
+        REQUIRE(diagnose(0).unwrap() == 42);
+        REQUIRE(diagnose(7).error().line == 7);
+        REQUIRE_THROWS_AS(diagnose(7).unwrap(), BadUnwrapException<Diagnostic>);
+
+        Result<void, Diagnostic> failed = Error {Diagnostic {"unexpected token", 3, 9}};
+        REQUIRE(std::string_view(failed.error().message) == "unexpected token");
+        REQUIRE(failed.map_error([](const Diagnostic& diagnostic) { return diagnostic.column; }).error() == 9);
+    }
+
+    SECTION("Copies, moves and assignment") {
+        Result<int, Diagnostic> original = diagnose(5);
+        Result<int, Diagnostic> copy = original;
+        REQUIRE(copy.error().line == 5);
+        REQUIRE(&copy.error() != &original.error());
+
+        const Diagnostic* block = &original.error();
+        Result<int, Diagnostic> moved = std::move(original);
+        REQUIRE(&moved.error() == block);
+
+        original = diagnose(0);
+        REQUIRE(original.unwrap() == 42);
+        copy = original;
+        REQUIRE(copy.unwrap() == 42);
+        copy = diagnose(8);
+        block = &copy.error();
+        copy = Error {Diagnostic {"", 9, 0}};
+        REQUIRE(&copy.error() == block);
+        REQUIRE(copy.error().line == 9);
+    }
+
+    SECTION("A moved-from boxed error may be assigned to or destroyed") {
+        Result<int, Diagnostic> source = diagnose(4);
+        Result<int, Diagnostic> target = std::move(source);
+        REQUIRE(target.error().line == 4);
+
+        source = Error {Diagnostic {"", 6, 0}};
+        REQUIRE(source.error().line == 6);
+
+        Result<int, Diagnostic> other = std::move(source);
+        source = target;
+        REQUIRE(source.error().line == 4);
+
+        Result<int, Diagnostic> dropped = std::move(other);
+        other = diagnose(0);
+        REQUIRE(other.unwrap() == 42);
+        REQUIRE(dropped.error().line == 6);
+
+        Result<void, Diagnostic> unit = Error {Diagnostic {"", 2, 0}};
+        Result<void, Diagnostic> moved = std::move(unit);
+        REQUIRE(moved.error().line == 2);
+    }
+
+    SECTION("Freed blocks are reused by the same thread") {
+        const Diagnostic* first = nullptr;
+        {
+            Result<int, Diagnostic> result = diagnose(1);
+            first = &result.error();
+        }
+        Result<int, Diagnostic> result = diagnose(2);
+        REQUIRE(&result.error() == first);
+    }
+
+    SECTION("Boxed errors are usable in constant expressions") {
+        STATIC_REQUIRE(diagnose(3).error().line == 3);
+        STATIC_REQUIRE(diagnose(0).unwrap() == 42);
+    }
+}
+
+struct MoveCounter {
+    static inline int moves = 0;
+    static inline int copies = 0;
+
+    int first;
+    int second;
+
+    MoveCounter(int a, int b) noexcept : first(a), second(b) {}
+    MoveCounter(const MoveCounter& other) : first(other.first), second(other.second) { ++copies; }
+    MoveCounter(MoveCounter&& other) noexcept : first(other.first), second(other.second) { ++moves; }
+    MoveCounter& operator=(const MoveCounter&) = default;
+    MoveCounter& operator=(MoveCounter&&) noexcept = default;
+};
+
+struct CopyCounter {
+    static inline int copies = 0;
+
+    int value;
+
+    explicit CopyCounter(int v) noexcept : value(v) {}
+    CopyCounter(const CopyCounter& other) noexcept : value(other.value) { ++copies; }
+    CopyCounter(CopyCounter&& other) noexcept = default;
+    CopyCounter& operator=(const CopyCounter&) = default;
+    CopyCounter& operator=(CopyCounter&&) noexcept = default;
+};
+
+// Copyable, but its move constructor may throw.
+struct ThrowingMove {
+    static inline int copies = 0;
+
+    int value;
+
+    explicit ThrowingMove(int v) : value(v) {}
+    ThrowingMove(const ThrowingMove& other) : value(other.value) { ++copies; }
+    ThrowingMove(ThrowingMove&& other) noexcept(false) : value(other.value) {}
+    ThrowingMove& operator=(const ThrowingMove&) = default;
+    ThrowingMove& operator=(ThrowingMove&&) noexcept(false) = default;
+};
+
+int negate(int value) noexcept { return -value; }
+int negate_may_throw(int value) { return -value; }
+Result<int, std::string> check_positive(int value) noexcept { return Ok {value}; }
+
+template <typename R, typename F>
+constexpr bool nothrow_map = noexcept(std::declval<R>().map(std::declval<F>()));
+
+template <typename R, typename F>
+constexpr bool nothrow_map_error = noexcept(std::declval<R>().map_error(std::declval<F>()));
+
+template <typename R, typename F>
+constexpr bool nothrow_and_then = noexcept(std::declval<R>().and_then(std::declval<F>()));
+
+TEST_CASE("Noexcept propagation", "[Result]") {
+    SECTION("Special members follow the payloads") {
+        STATIC_REQUIRE(std::is_nothrow_move_constructible_v<Result<std::string, std::string>>);
+        STATIC_REQUIRE(std::is_nothrow_move_assignable_v<Result<std::string, std::string>>);
+        STATIC_REQUIRE(std::is_nothrow_move_constructible_v<Result<std::vector<int>, std::unique_ptr<int>>>);
+        STATIC_REQUIRE(std::is_nothrow_move_assignable_v<Result<std::vector<int>, std::unique_ptr<int>>>);
+        STATIC_REQUIRE(std::is_nothrow_move_constructible_v<Result<void, std::string>>);
+        STATIC_REQUIRE(std::is_nothrow_move_constructible_v<Result<int, Diagnostic>>);
+        STATIC_REQUIRE(std::is_nothrow_copy_constructible_v<Result<int, ParseError>>);
+        STATIC_REQUIRE(std::is_nothrow_copy_assignable_v<Result<CopyCounter, ParseError>>);
+
+        STATIC_REQUIRE_FALSE(std::is_nothrow_copy_constructible_v<Result<std::string, int>>);
+        STATIC_REQUIRE_FALSE(std::is_nothrow_copy_assignable_v<Result<std::string, int>>);
+        STATIC_REQUIRE_FALSE(std::is_nothrow_copy_constructible_v<Result<int, Diagnostic>>);
+        STATIC_REQUIRE_FALSE(std::is_nothrow_move_constructible_v<Result<ThrowingMove, int>>);
+        STATIC_REQUIRE_FALSE(std::is_nothrow_move_assignable_v<Result<int, ThrowingMove>>);
+    }
+
+    SECTION("Construction and assignment from payloads") {
+        STATIC_REQUIRE(std::is_nothrow_constructible_v<Ok<std::string>, std::string>);
+        STATIC_REQUIRE_FALSE(std::is_nothrow_constructible_v<Ok<std::string>, const std::string&>);
+        STATIC_REQUIRE_FALSE(std::is_nothrow_constructible_v<Error<ThrowingMove>, ThrowingMove>);
+
+        STATIC_REQUIRE(std::is_nothrow_constructible_v<Result<std::string, int>, Ok<std::string>>);
+        STATIC_REQUIRE(std::is_nothrow_constructible_v<Result<int, std::string>, InPlaceErrorTag, std::string&&>);
+        STATIC_REQUIRE_FALSE(std::is_nothrow_constructible_v<Result<int, std::string>, InPlaceErrorTag, const char*>);
+        STATIC_REQUIRE_FALSE(std::is_nothrow_constructible_v<Result<ThrowingMove, int>, Ok<ThrowingMove>>);
+        STATIC_REQUIRE_FALSE(std::is_nothrow_constructible_v<Result<int, Diagnostic>, Error<Diagnostic>>);
+
+        STATIC_REQUIRE(std::is_nothrow_assignable_v<Result<std::string, int>&, Ok<std::string>>);
+        STATIC_REQUIRE(std::is_nothrow_assignable_v<Result<void, std::string>&, Ok<>>);
+        STATIC_REQUIRE_FALSE(std::is_nothrow_assignable_v<Result<int, ThrowingMove>&, Error<ThrowingMove>>);
+    }
+
+    SECTION("Combinators account for the payload they pass through") {
+        using Negate = int (*)(int) noexcept;
+        using NegateMayThrow = int (*)(int);
+
+        STATIC_REQUIRE(nothrow_map<const Result<int, int>&, Negate>);
+        STATIC_REQUIRE(nothrow_map<Result<int, std::string>, Negate>);
+        STATIC_REQUIRE_FALSE(nothrow_map<const Result<int, std::string>&, Negate>);
+        STATIC_REQUIRE_FALSE(nothrow_map<Result<int, int>, NegateMayThrow>);
+
+        STATIC_REQUIRE(nothrow_map_error<const Result<int, int>&, Negate>);
+        STATIC_REQUIRE(nothrow_map_error<Result<std::string, int>, Negate>);
+        STATIC_REQUIRE_FALSE(nothrow_map_error<const Result<std::string, int>&, Negate>);
+        STATIC_REQUIRE_FALSE(nothrow_map_error<Result<int, int>, NegateMayThrow>);
+
+        using Check = Result<int, std::string> (*)(int) noexcept;
+        STATIC_REQUIRE(nothrow_and_then<Result<int, std::string>, Check>);
+        STATIC_REQUIRE_FALSE(nothrow_and_then<const Result<int, std::string>&, Check>);
+
+        REQUIRE(Result<int, std::string>(Ok {2}).map(negate).unwrap() == -2);
+        REQUIRE(Result<int, int>(Error {2}).map_error(negate_may_throw).error() == -2);
+        REQUIRE(Result<int, std::string>(Ok {3}).and_then(check_positive).unwrap() == 3);
+    }
+
+    SECTION("Vector reallocation moves nothrow-movable Results") {
+        CopyCounter::copies = 0;
+        std::vector<Result<CopyCounter, std::string>> results;
+        for (int i = 0; i < 100; ++i) {
+            results.emplace_back(in_place_ok, i);
+        }
+        REQUIRE(CopyCounter::copies == 0);
+
+        std::vector<Result<int, Diagnostic>> boxed;
+        for (int i = 0; i < 100; ++i) {
+            boxed.push_back(diagnose(i));
+        }
+        REQUIRE(boxed[99].error().line == 99);
+
+        // Moving could throw halfway through, so vector falls back to copies.
+        ThrowingMove::copies = 0;
+        std::vector<Result<ThrowingMove, int>> throwing;
+        for (int i = 0; i < 100; ++i) {
+            throwing.emplace_back(in_place_ok, i);
+        }
+        REQUIRE(ThrowingMove::copies > 0);
+    }
+}
+
+TEST_CASE("In-place construction", "[Result]") {
+    MoveCounter::moves = 0;
+    MoveCounter::copies = 0;
+
+    SECTION("In-place constructors build the payload directly") {
+        Result<MoveCounter, MoveCounter> result_ok(in_place_ok, 1, 2);
+        REQUIRE(result_ok.unwrap().first == 1);
+        REQUIRE(result_ok.unwrap().second == 2);
+
+        Result<MoveCounter, MoveCounter> result_error(in_place_error, 3, 4);
+        REQUIRE(result_error.error().first == 3);
+
+        REQUIRE(MoveCounter::moves == 0);
+        REQUIRE(MoveCounter::copies == 0);
+    }
+
+    SECTION("Factory functions elide all moves") {
+        auto result_ok = make_ok<MoveCounter, int>(5, 6);
+        REQUIRE(result_ok.unwrap().first == 5);
+
+        auto result_error = make_error<int, MoveCounter>(7, 8);
+        REQUIRE(result_error.error().second == 8);
+
+        auto void_ok = make_ok<void, MoveCounter>();
+        REQUIRE(!void_ok.has_error());
+
+        REQUIRE(MoveCounter::moves == 0);
+        REQUIRE(MoveCounter::copies == 0);
+    }
+
+    SECTION("Emplace replaces the active alternative") {
+        Result<MoveCounter, std::string> result(Error<std::string> {"error"});
+        MoveCounter& value = result.emplace_ok(9, 10);
+        REQUIRE(result.has_value());
+        REQUIRE(&value == &result.unwrap());
+        REQUIRE(value.second == 10);
+
+        std::string& error = result.emplace_error(3, 'x');
+        REQUIRE(result.has_error());
+        REQUIRE(error == "xxx");
+
+        REQUIRE(MoveCounter::moves == 0);
+        REQUIRE(MoveCounter::copies == 0);
+    }
+
+    SECTION("Emplace on void specialization") {
+        Result<void, std::string> result(Ok<> {});
+        result.emplace_error("error");
+        REQUIRE(result.error() == "error");
+        result.emplace_ok();
+        REQUIRE(!result.has_error());
+    }
+
+    SECTION("Ok and Error support in-place payloads") {
+        Ok<MoveCounter> ok(std::in_place, 1, 2);
+        Error<MoveCounter> error(std::in_place, 3, 4);
+        REQUIRE(ok.value.first == 1);
+        REQUIRE(error.value.first == 3);
+        REQUIRE(MoveCounter::moves == 0);
+    }
+}
+
+TEST_CASE("Unchecked accessors", "[Result]") {
+    SECTION("Unchecked access after testing the Result") {
+        Result<std::string, int> result(Ok<std::string> {"value"});
+        REQUIRE(result);
+        REQUIRE(result.unwrap_unchecked() == "value");
+        REQUIRE(*result == "value");
+        REQUIRE(result->size() == 5);
+
+        result->append("s");
+        REQUIRE(result.unwrap() == "values");
+
+        std::string moved = *std::move(result);
+        REQUIRE(moved == "values");
+    }
+
+    SECTION("Unchecked error access") {
+        Result<int, std::string> result(Error<std::string> {"error"});
+        REQUIRE(!result);
+        REQUIRE(result.error_unchecked() == "error");
+        result.error_unchecked() += "!";
+        REQUIRE(std::move(result).error_unchecked() == "error!");
+    }
+
+    SECTION("Unchecked access on void specialization") {
+        Result<void, std::string> result_ok(Ok<> {});
+        REQUIRE_NOTHROW(result_ok.unwrap_unchecked());
+
+        Result<void, std::string> result_error(Error<std::string> {"error"});
+        REQUIRE(result_error.error_unchecked() == "error");
+    }
+
+    SECTION("Unchecked accessors are noexcept and constexpr") {
+        constexpr Result<int, const char*> result = create_ok();
+        STATIC_REQUIRE(*result == 42);
+        STATIC_REQUIRE(noexcept(result.unwrap_unchecked()));
+        STATIC_REQUIRE(noexcept(*result));
+    }
+}
+
+// Counts its own copies and invocations; map() should use the caller's instance.
+struct CountingMapper {
+    static inline int copies = 0;
+
+    int calls = 0;
+
+    CountingMapper() = default;
+    CountingMapper(const CountingMapper& other) : calls(other.calls) { ++copies; }
+    CountingMapper& operator=(const CountingMapper&) = default;
+
+    int operator()(int value) & { return value + ++calls; }
+    std::size_t operator()(const std::string& error) & { return error.size() + ++calls; }
+};
+
+TEST_CASE("Reference-qualified accessors and combinators", "[Result]") {
+    SECTION("Mutable access through unwrap() and error()") {
+        Result<std::string, int> ok(Ok<std::string> {"value"});
+        ok.unwrap() += "s";
+        REQUIRE(ok.unwrap() == "values");
+
+        Result<int, std::string> failed(Error<std::string> {"error"});
+        failed.error().append("!");
+        REQUIRE(failed.error() == "error!");
+
+        Result<void, std::string> void_failed(Error<std::string> {"error"});
+        void_failed.error().clear();
+        REQUIRE(void_failed.error().empty());
+    }
+
+    SECTION("Accessors follow the value category of the Result") {
+        using R = Result<std::string, int>;
+        STATIC_REQUIRE(std::is_same_v<decltype(std::declval<R&>().unwrap()), std::string&>);
+        STATIC_REQUIRE(std::is_same_v<decltype(std::declval<const R&>().unwrap()), const std::string&>);
+        STATIC_REQUIRE(std::is_same_v<decltype(std::declval<R>().unwrap()), std::string&&>);
+        STATIC_REQUIRE(std::is_same_v<decltype(std::declval<const R>().unwrap()), const std::string&&>);
+        STATIC_REQUIRE(std::is_same_v<decltype(std::declval<R&>().error()), int&>);
+        STATIC_REQUIRE(std::is_same_v<decltype(std::declval<const R>().error()), const int&&>);
+
+        const R ok(Ok<std::string> {"value"});
+        std::string copied = std::move(ok).unwrap();
+        REQUIRE(copied == "value");
+        REQUIRE(ok.unwrap() == "value");
+    }
+
+    SECTION("map() on an lvalue passes a mutable reference") {
+        Result<int, std::string> ok(Ok<int> {20});
+        auto doubled = ok.map([](int& value) { return value *= 2; });
+        REQUIRE(doubled.unwrap() == 40);
+        REQUIRE(ok.unwrap() == 40);
+
+        Result<int, std::string> failed(Error<std::string> {"bad"});
+        auto marked = failed.map_error([](std::string& error) { return (error += "!").size(); });
+        REQUIRE(marked.error() == 4);
+        REQUIRE(failed.error() == "bad!");
+    }
+
+    SECTION("Callables are forwarded, not copied") {
+        CountingMapper::copies = 0;
+        CountingMapper mapper;
+
+        Result<int, std::string> ok(Ok<int> {10});
+        REQUIRE(ok.map(mapper).unwrap() == 11);
+        REQUIRE(ok.map(mapper).unwrap() == 12);
+
+        Result<int, std::string> failed(Error<std::string> {"bad"});
+        REQUIRE(failed.map_error(mapper).error() == 6);
+
+        Result<void, std::string> void_failed(Error<std::string> {"bad"});
+        REQUIRE(void_failed.map_error(mapper).error() == 7);
+
+        REQUIRE(mapper.calls == 4);
+        REQUIRE(CountingMapper::copies == 0);
+    }
+
+    SECTION("Move-only callables") {
+        auto offset = std::make_unique<int>(5);
+        Result<int, std::string> ok(Ok<int> {1});
+        auto shifted = ok.map([offset = std::move(offset)](int value) { return value + *offset; });
+        REQUIRE(shifted.unwrap() == 6);
+    }
+
+    SECTION("Rvalue Results move the payload into the callable") {
+        MoveCounter::moves = 0;
+        MoveCounter::copies = 0;
+        Result<MoveCounter, std::string> result(in_place_ok, 1, 2);
+        auto sum = std::move(result).map([](MoveCounter&& value) { return value.first + value.second; });
+        REQUIRE(sum.unwrap() == 3);
+        REQUIRE(MoveCounter::moves == 0);
+        REQUIRE(MoveCounter::copies == 0);
+    }
+}
+
+Result<int, std::string> parse_digit(char c) {
+    if (c < '0' || c > '9') {
+        return Error<std::string> {"not a digit"};
+    }
+    return Ok<int> {c - '0'};
+}
+
+TEST_CASE("Monadic combinators", "[Result]") {
+    SECTION("and_then chains fallible steps") {
+        Result<char, std::string> input(Ok<char> {'7'});
+        auto chained = input.and_then(parse_digit);
+        REQUIRE(chained.unwrap() == 7);
+
+        Result<char, std::string> bad_input(Ok<char> {'x'});
+        REQUIRE(bad_input.and_then(parse_digit).error() == "not a digit");
+
+        Result<char, std::string> error(Error<std::string> {"no input"});
+        REQUIRE(error.and_then(parse_digit).error() == "no input");
+    }
+
+    SECTION("or_else recovers from errors") {
+        Result<int, std::string> error(Error<std::string> {"missing"});
+        auto recovered = error.or_else([](const std::string& e) -> Result<int, int> {
+            return Ok<int> {static_cast<int>(e.size())};
+        });
+        REQUIRE(recovered.unwrap() == 7);
+
+        Result<int, std::string> ok(Ok<int> {1});
+        auto untouched = ok.or_else([](const std::string&) -> Result<int, int> { return Error<int> {0}; });
+        REQUIRE(untouched.unwrap() == 1);
+    }
+
+    SECTION("transform and transform_error") {
+        Result<int, std::string> ok(Ok<int> {20});
+        REQUIRE(ok.transform([](int x) { return x + 1; }).unwrap() == 21);
+        REQUIRE(ok.transform_error([](const std::string& e) { return e.size(); }).unwrap() == 20);
+
+        Result<int, std::string> error(Error<std::string> {"bad"});
+        REQUIRE(error.transform([](int x) { return x + 1; }).error() == "bad");
+        REQUIRE(error.transform_error([](const std::string& e) { return e.size(); }).error() == 3);
+
+        int calls = 0;
+        Result<void, std::string> void_result = ok.transform([&](int) { ++calls; });
+        REQUIRE(!void_result.has_error());
+        REQUIRE(calls == 1);
+    }
+
+    SECTION("Combinators on void specialization") {
+        Result<void, std::string> ok(Ok<> {});
+        REQUIRE(ok.transform([] { return 5; }).unwrap() == 5);
+        REQUIRE(ok.and_then([] { return parse_digit('3'); }).unwrap() == 3);
+
+        Result<void, std::string> error(Error<std::string> {"failed"});
+        REQUIRE(error.transform_error([](const std::string& e) { return e + "!"; }).error() == "failed!");
+        REQUIRE(!error.or_else([](const std::string&) -> Result<void, int> { return Ok<> {}; }).has_error());
+    }
+
+    SECTION("Payloads are forwarded without extra moves") {
+        MoveCounter::moves = 0;
+        MoveCounter::copies = 0;
+
+        Result<MoveCounter, std::string> result(in_place_ok, 1, 2);
+        auto transformed = std::move(result)
+            .transform([](MoveCounter&& value) { return MoveCounter(value.first + 1, value.second); })
+            .and_then([](MoveCounter&& value) { return make_ok<MoveCounter, std::string>(value.first * 10, 0); });
+        REQUIRE(transformed.unwrap().first == 20);
+        REQUIRE(MoveCounter::moves == 0);
+        REQUIRE(MoveCounter::copies == 0);
+
+        auto forwarded = std::move(transformed).transform_error([](std::string&& e) { return e.size(); });
+        REQUIRE(forwarded.unwrap().first == 20);
+        REQUIRE(MoveCounter::moves == 1);
+        REQUIRE(MoveCounter::copies == 0);
+    }
+
+    SECTION("Move-only payloads through chains") {
+        Result<NonCopyable, std::string> result(Ok<NonCopyable> {NonCopyable(4)});
+        auto chained = std::move(result)
+            .transform([](NonCopyable&& nc) { return NonCopyable(nc.value * 2); })
+            .and_then([](NonCopyable&& nc) -> Result<int, std::string> { return Ok<int> {nc.value + 1}; });
+        REQUIRE(chained.unwrap() == 9);
+    }
+}
+
+TEST_CASE("Lazy pipelines", "[Result]") {
+    SECTION("Map chain is fused into one evaluation") {
+        Result<int, std::string> result(Ok<int> {1});
+        Result<std::string, std::size_t> fused = result.lazy()
+            .map([](int x) { return x + 1; })
+            .map([](int x) { return x * 10; })
+            .map_error([](const std::string& e) { return e.size(); })
+            .map([](int x) { return std::to_string(x); })
+            .run();
+        REQUIRE(fused.unwrap() == "20");
+    }
+
+    SECTION("Error side is composed independently") {
+        Result<int, std::string> result(Error<std::string> {"abc"});
+        int ok_calls = 0;
+        Result<int, std::size_t> fused = result.lazy()
+            .map([&](int x) { ++ok_calls; return x; })
+            .map_error([](const std::string& e) { return e + "def"; })
+            .map_error([](std::string&& e) { return e.size(); });
+        REQUIRE(fused.error() == 6);
+        REQUIRE(ok_calls == 0);
+    }
+
+    SECTION("Matches the eager chain") {
+        auto stage = [](int x) { return x * 3 + 1; };
+        Result<int, std::string> result(Ok<int> {5});
+        auto eager = result.map(stage).map(stage).map(stage);
+        auto lazy = result.lazy().map(stage).map(stage).map(stage).run();
+        REQUIRE(eager.unwrap() == lazy.unwrap());
+    }
+
+    SECTION("Payload is moved once from an rvalue source") {
+        MoveCounter::moves = 0;
+        MoveCounter::copies = 0;
+
+        Result<MoveCounter, std::string> result(in_place_ok, 1, 2);
+        auto identity = std::move(result).lazy().map_error([](std::string&& e) { return e.size(); }).run();
+        REQUIRE(identity.unwrap().first == 1);
+        REQUIRE(MoveCounter::moves == 1);
+        REQUIRE(MoveCounter::copies == 0);
+
+        auto mapped = make_ok<MoveCounter, std::string>(3, 4)
+            .lazy()
+            .map([](MoveCounter&& value) { return MoveCounter(value.first + 1, value.second); })
+            .map([](MoveCounter&& value) { return MoveCounter(value.first * 2, value.second); })
+            .run();
+        REQUIRE(mapped.unwrap().first == 8);
+        REQUIRE(MoveCounter::moves == 1);
+        REQUIRE(MoveCounter::copies == 0);
+    }
+
+    SECTION("Void stages and void source") {
+        Result<void, std::string> source(Ok<> {});
+        int calls = 0;
+        Result<void, std::string> fused = source.lazy()
+            .map([&] { ++calls; return 2; })
+            .map([&](int x) { calls += x; })
+            .run();
+        REQUIRE(!fused.has_error());
+        REQUIRE(calls == 3);
+    }
+
+    SECTION("Pipelines are usable in constant expressions") {
+        constexpr auto result = create_ok().lazy().map([](int x) { return x / 2; }).run();
+        STATIC_REQUIRE(result.unwrap() == 21);
+    }
+}
+
+Result<int, std::string> add_digits(char a, char b) {
+    RESULT_TRY(int first, parse_digit(a));
+    RESULT_TRY(int second, parse_digit(b));
+    return Ok<int> {first + second};
+}
+
+Result<void, std::string> check_digit(char c) {
+    RESULT_TRY_VOID(parse_digit(c));
+    return Ok<> {};
+}
+
+TEST_CASE("RESULT_TRY propagation", "[Result]") {
+    SECTION("Values are unwrapped") {
+        REQUIRE(add_digits('3', '4').unwrap() == 7);
+    }
+
+    SECTION("First error is returned") {
+        REQUIRE(add_digits('x', '4').error() == "not a digit");
+        REQUIRE(add_digits('3', 'y').error() == "not a digit");
+    }
+
+    SECTION("Void propagation") {
+        REQUIRE(!check_digit('1').has_error());
+        REQUIRE(check_digit('z').error() == "not a digit");
+    }
+}
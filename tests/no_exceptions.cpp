@@ -0,0 +1,78 @@
+// Built with -fno-exceptions -fno-rtti. Catch2 needs exceptions, so this driver reports failures
+// through its exit code. Passing "unwrap" or "error" as the first argument misuses a Result and
+// expects the installed panic handler to be reached.
+#include <cstdio>
+#include <cstring>
+#include <result/result.hpp>
+#include <string_view>
+
+using namespace result;
+
+enum class ReadError { Eof, Corrupt };
+
+template <>
+struct result::ErrorDescription<ReadError> {
+    static std::string_view description(ReadError error) {
+        switch (error) {
+        case ReadError::Eof: return "end of file";
+        case ReadError::Corrupt: return "corrupt record";
+        }
+        return "unknown";
+    }
+};
+
+#ifndef RESULT_NO_EXCEPTIONS
+#error "RESULT_NO_EXCEPTIONS should be implied by -fno-exceptions"
+#endif
+
+namespace {
+    int failures = 0;
+
+    void check(bool condition, const char* expression, int line) {
+        if (!condition) {
+            std::printf("no_exceptions.cpp:%d: check failed: %s\n", line, expression);
+            ++failures;
+        }
+    }
+
+    void print_and_exit(std::string_view message) noexcept {
+        std::printf("panic: %.*s\n", static_cast<int>(message.size()), message.data());
+        std::fflush(stdout);
+        std::_Exit(0);
+    }
+}
+
+#define CHECK(expression) check((expression), #expression, __LINE__)
+
+int main(int argc, char** argv) {
+    set_panic_handler(&print_and_exit);
+
+    if (argc > 1 && std::strcmp(argv[1], "unwrap") == 0) {
+        Result<int, ReadError> result(Error<ReadError> {ReadError::Corrupt});
+        (void)result.unwrap();
+        return 1;
+    }
+
+    if (argc > 1 && std::strcmp(argv[1], "error") == 0) {
+        Result<void, ReadError> result(Ok<> {});
+        (void)result.error();
+        return 1;
+    }
+
+    Result<int, ReadError> result_ok(Ok<int> {42});
+    CHECK(result_ok.has_value());
+    CHECK(result_ok.unwrap() == 42);
+    CHECK(result_ok.map([](int x) { return x + 1; }).unwrap() == 43);
+
+    Result<int, ReadError> result_error(Error<ReadError> {ReadError::Eof});
+    CHECK(result_error.has_error());
+    CHECK(result_error.error() == ReadError::Eof);
+
+    result_error = Ok<int> {7};
+    CHECK(result_error.unwrap() == 7);
+
+    Result<void, ReadError> void_error(Error<ReadError> {ReadError::Corrupt});
+    CHECK(void_error.map_error([](ReadError) { return 1; }).error() == 1);
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,119 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <result/packed_result.hpp>
+#include <type_traits>
+
+using namespace result;
+
+namespace {
+    enum class Code : std::uint8_t { Truncated = 1, Invalid };
+
+    struct Point {
+        std::int16_t x;
+        std::int16_t y;
+    };
+
+    using Field = PackedResult<std::uint32_t, Code>;
+
+    [[gnu::noinline]] Field read_field(const std::uint8_t* bytes, std::size_t size) {
+        if (size < 2) {
+            return Error<Code> {Code::Truncated};
+        }
+        if (bytes[0] == 0xff) {
+            return Error<Code> {Code::Invalid};
+        }
+        return Ok<std::uint32_t> {std::uint32_t {bytes[0]} | std::uint32_t {bytes[1]} << 8};
+    }
+
+    Field sum_fields(const std::uint8_t* bytes, std::size_t size) {
+        RESULT_TRY(std::uint32_t first, read_field(bytes, size));
+        RESULT_TRY(std::uint32_t second, read_field(bytes + 2, size - 2));
+        return Ok<std::uint32_t> {first + second};
+    }
+
+    constexpr Field twice(Field field) {
+        return field.map([](std::uint32_t value) { return value * 2; });
+    }
+}
+
+static_assert(sizeof(Field) == sizeof(std::uint64_t));
+static_assert(std::is_trivially_copyable_v<Field>);
+static_assert(sizeof(PackedResult<void, Code>) == sizeof(std::uint64_t));
+static_assert(!Packable<std::uint64_t>);
+static_assert(!Packable<const char*>);
+static_assert(Packable<Point>);
+
+TEST_CASE("Packed results", "[PackedResult]") {
+    SECTION("Ok and Error round-trip through the word") {
+        Field ok = Ok<std::uint32_t> {0xffffffffu};
+        REQUIRE(ok.has_value());
+        REQUIRE(ok.unwrap() == 0xffffffffu);
+        REQUIRE(*ok == 0xffffffffu);
+
+        Field failed = Error<Code> {Code::Invalid};
+        REQUIRE(failed.has_error());
+        REQUIRE(!failed);
+        REQUIRE(failed.error() == Code::Invalid);
+        REQUIRE_THROWS_AS(failed.unwrap(), BadUnwrapException<Code>);
+        REQUIRE_THROWS(ok.error());
+
+        PackedResult<Point, Code> point = Ok<Point> {{-3, 4}};
+        REQUIRE(point.unwrap().x == -3);
+        REQUIRE(point.unwrap().y == 4);
+    }
+
+    SECTION("Usable in constant expressions") {
+        STATIC_REQUIRE(twice(Ok<std::uint32_t> {21}).unwrap() == 42);
+        STATIC_REQUIRE(twice(Error<Code> {Code::Truncated}).error() == Code::Truncated);
+    }
+
+    SECTION("Across non-inlined calls") {
+        const std::uint8_t bytes[] = {0x01, 0x02, 0x03, 0x04};
+        REQUIRE(read_field(bytes, 4).unwrap() == 0x0201);
+        REQUIRE(sum_fields(bytes, 4).unwrap() == 0x0201 + 0x0403);
+        REQUIRE(sum_fields(bytes, 3).error() == Code::Truncated);
+
+        const std::uint8_t invalid[] = {0x01, 0x02, 0xff, 0x04};
+        REQUIRE(sum_fields(invalid, 4).error() == Code::Invalid);
+    }
+
+    SECTION("map and map_error") {
+        Field ok = Ok<std::uint32_t> {7};
+        PackedResult<float, Code> scaled = ok.map([](std::uint32_t value) { return value * 0.5f; });
+        REQUIRE(scaled.unwrap() == 3.5f);
+        REQUIRE(ok.map_error([](Code code) { return static_cast<int>(code); }).unwrap() == 7);
+
+        Field failed = Error<Code> {Code::Invalid};
+        REQUIRE(failed.map([](std::uint32_t value) { return value + 1; }).error() == Code::Invalid);
+        PackedResult<std::uint32_t, std::int16_t> negated =
+            failed.map_error([](Code code) { return static_cast<std::int16_t>(-static_cast<int>(code)); });
+        REQUIRE(negated.error() == -2);
+
+        int calls = 0;
+        PackedResult<void, Code> checked = ok.map([&](std::uint32_t) { ++calls; });
+        REQUIRE(checked.has_value());
+        REQUIRE(checked.map([] { return 'x'; }).unwrap() == 'x');
+        REQUIRE(calls == 1);
+    }
+
+    SECTION("Conversion to and from Result") {
+        Result<std::uint32_t, Code> unpacked = Field(Ok<std::uint32_t> {5});
+        REQUIRE(unpacked.unwrap() == 5);
+        Field packed = unpacked.map([](std::uint32_t value) { return value + 1; });
+        REQUIRE(packed.unwrap() == 6);
+
+        Result<void, Code> failed = PackedResult<void, Code>(Error<Code> {Code::Truncated});
+        REQUIRE(failed.error() == Code::Truncated);
+        REQUIRE(PackedResult<void, Code>(failed).error() == Code::Truncated);
+    }
+
+    SECTION("Raw bits") {
+        Field ok = Ok<std::uint32_t> {9};
+        REQUIRE(ok.bits() == ((std::uint64_t {1} << 63) | 9));
+        REQUIRE(Field::from_bits(ok.bits()).unwrap() == 9);
+
+        Field failed = Error<Code> {Code::Invalid};
+        REQUIRE(failed.bits() == static_cast<std::uint64_t>(Code::Invalid));
+        REQUIRE(Field::from_bits(failed.bits()).error() == Code::Invalid);
+    }
+}
@@ -0,0 +1,162 @@
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <cstdint>
+#include <numeric>
+#include <result/parallel.hpp>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace result;
+
+namespace {
+    std::vector<int> make_records(std::size_t size) {
+        std::vector<int> records(size);
+        std::iota(records.begin(), records.end(), 0);
+        return records;
+    }
+
+    // Validation that rejects the given record numbers.
+    struct Validate {
+        std::vector<int> rejected;
+        std::atomic<std::size_t>* calls = nullptr;
+
+        Result<long, std::string> operator()(int record) const {
+            if (calls) {
+                calls->fetch_add(1, std::memory_order_relaxed);
+            }
+            for (int bad : rejected) {
+                if (record == bad) {
+                    return Error {"bad record " + std::to_string(record)};
+                }
+            }
+            return Ok {record * 2L};
+        }
+    };
+
+    Result<std::size_t, int> lift(std::size_t value) {
+        return Ok {value};
+    }
+
+    // A fold whose values do not convert to the accumulator: each chunk would have to start from
+    // an empty vector rather than from its first value.
+    struct Append {
+        std::vector<int> operator()(std::vector<int> all, std::size_t value) const {
+            all.push_back(static_cast<int>(value));
+            return all;
+        }
+
+        std::vector<int> operator()(std::vector<int> all, const std::vector<int>& more) const {
+            all.insert(all.end(), more.begin(), more.end());
+            return all;
+        }
+    };
+
+    template <typename T, typename Op>
+    concept Reducible = requires(std::vector<std::size_t>& input, T init, Op op) {
+        try_reduce(input, init, op, lift);
+    };
+}
+
+TEST_CASE("Parallel algorithms", "[Parallel]") {
+    const ParallelOptions options {.threads = 4, .chunk_size = 1000};
+
+    SECTION("try_transform writes every value") {
+        auto records = make_records(100'000);
+        auto doubled = try_transform(records, Validate {}, options);
+        REQUIRE(doubled.unwrap().size() == records.size());
+        REQUIRE(doubled.unwrap()[12345] == 24690);
+    }
+
+    SECTION("The lowest failing index wins regardless of scheduling") {
+        auto records = make_records(100'000);
+        for (int run = 0; run < 20; ++run) {
+            auto result = try_transform(records, Validate {{70'000, 30'001, 99'999}}, options);
+            REQUIRE(result.error() == "bad record 30001");
+        }
+        REQUIRE(try_transform(records, Validate {{5}}, ParallelOptions {.threads = 1}).error() == "bad record 5");
+    }
+
+    SECTION("Work past an error is cancelled") {
+        auto records = make_records(1'000'000);
+        std::atomic<std::size_t> calls {0};
+        auto result = try_transform(records, Validate {{10}, &calls}, ParallelOptions {.threads = 4, .chunk_size = 100});
+        REQUIRE(result.has_error());
+        REQUIRE(calls.load() < 10'000);
+    }
+
+    SECTION("Caller-provided output") {
+        auto records = make_records(5000);
+        std::vector<long> output(5000);
+        auto filled = try_transform(records, std::span<long>(output), Validate {}, options);
+        REQUIRE(filled.unwrap().data() == output.data());
+        REQUIRE(output[4999] == 9998);
+    }
+
+    SECTION("An undersized output is rejected before any work") {
+        auto records = make_records(5000);
+        std::vector<long> output(4999);
+        std::atomic<std::size_t> calls {0};
+        REQUIRE_THROWS_AS(try_transform(records, std::span<long>(output), Validate {{}, &calls}, options), std::length_error);
+        REQUIRE(calls.load() == 0);
+    }
+
+    SECTION("try_for_each") {
+        auto records = make_records(50'000);
+        auto check = [](int record) -> Result<void, int> {
+            if (record % 20'000 == 19'999) {
+                return Error {record};
+            }
+            return Ok<> {};
+        };
+        REQUIRE(try_for_each(records, check, options).error() == 19'999);
+        REQUIRE_FALSE(try_for_each(std::span(records).first(19'999), check, options).has_error());
+    }
+
+    SECTION("try_reduce combines chunks in order") {
+        std::string digits;
+        for (int i = 0; i < 5000; ++i) {
+            digits += static_cast<char>('0' + i % 10);
+        }
+        auto as_string = [](char c) -> Result<std::string, char> {
+            if (c < '0' || c > '9') {
+                return Error {c};
+            }
+            return Ok {std::string(1, c)};
+        };
+        auto concatenated = try_reduce(digits, std::string(), std::plus<> {}, as_string, ParallelOptions {.threads = 4, .chunk_size = 7});
+        REQUIRE(concatenated.unwrap() == digits);
+
+        auto records = make_records(10'000);
+        auto sum = try_reduce(records, 0L, std::plus<> {}, Validate {}, options);
+        REQUIRE(sum.unwrap() == 9999L * 10'000);
+        REQUIRE(try_reduce(records, 0L, std::plus<> {}, Validate {{4321, 8000}}, options).error() == "bad record 4321");
+    }
+
+    SECTION("try_reduce folds values of another type into the accumulator") {
+        std::vector<int> large(4000, 1 << 30);
+        auto widen = [](int value) -> Result<int, std::string> { return Ok {value}; };
+        auto sum = try_reduce(large, std::int64_t {0}, std::plus<std::int64_t> {}, widen, options);
+        REQUIRE(sum.unwrap() == std::int64_t {4000} << 30);
+
+        STATIC_REQUIRE(Reducible<std::size_t, std::plus<>>);
+        STATIC_REQUIRE(!Reducible<std::vector<int>, Append>);
+    }
+
+    SECTION("Empty input") {
+        std::vector<int> records;
+        REQUIRE(try_transform(records, Validate {}, options).unwrap().empty());
+        REQUIRE(try_reduce(records, 7L, std::plus<> {}, Validate {}, options).unwrap() == 7);
+    }
+
+    SECTION("Exceptions are rethrown on the calling thread") {
+        auto records = make_records(10'000);
+        auto throwing = [](int record) -> Result<int, int> {
+            if (record == 6000) {
+                throw std::runtime_error("boom");
+            }
+            return Ok {record};
+        };
+        REQUIRE_THROWS_AS(try_transform(records, throwing, options), std::runtime_error);
+    }
+}
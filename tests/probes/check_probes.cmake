@@ -0,0 +1,26 @@
+# Usage: cmake -DREADELF=<readelf> -DEXECUTABLE=<probes executable> -P check_probes.cmake
+#
+# Checks that the executable carries a SystemTap SDT note for every probe of provider "result".
+
+set(PROBES error unwrap_failed map_error)
+
+execute_process(
+    COMMAND ${READELF} --notes ${EXECUTABLE}
+    OUTPUT_VARIABLE notes
+    RESULT_VARIABLE readelf_result
+)
+if(NOT readelf_result EQUAL 0)
+    message(FATAL_ERROR "readelf failed on ${EXECUTABLE}")
+endif()
+
+set(failures 0)
+foreach(probe IN LISTS PROBES)
+    if(NOT notes MATCHES "Provider: result\n[ \t]*Name: ${probe}\n")
+        message(SEND_ERROR "${probe}: no stapsdt note in ${EXECUTABLE}")
+        math(EXPR failures "${failures} + 1")
+    endif()
+endforeach()
+
+if(failures GREATER 0)
+    message(FATAL_ERROR "${failures} probe check(s) failed")
+endif()
@@ -0,0 +1,44 @@
+// Built with RESULT_ENABLE_PROBES. Exercises every probe site; check_probes.cmake then looks for
+// their notes in the executable, and running it checks that the probes do not change behaviour.
+#include <cstdio>
+#include <result/result.hpp>
+#include <string>
+
+using namespace result;
+
+#ifndef RESULT_PROBES_SUPPORTED
+#error "probes are not supported on this platform"
+#endif
+
+namespace {
+    enum class ParseError { Empty, Garbage };
+
+    Result<int, ParseError> parse(const std::string& text) {
+        if (text.empty()) {
+            return Error {ParseError::Empty};
+        }
+        return Ok {static_cast<int>(text.size())};
+    }
+
+    constexpr Result<int, int> folded = Error {1};
+    static_assert(folded.has_error());
+}
+
+int main(int argc, char**) {
+    int failures = 0;
+
+    Result<int, std::string> described = parse(argc > 8 ? "text" : "").map_error([](ParseError) { return std::string("empty input"); });
+    if (!described.has_error() || described.error() != "empty input") {
+        std::puts("map_error changed the result");
+        ++failures;
+    }
+
+    try {
+        (void)parse("").unwrap();
+        std::puts("unwrap() did not throw");
+        ++failures;
+    } catch (const BadUnwrapException<ParseError>&) {
+    }
+
+    return failures;
+}
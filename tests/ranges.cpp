@@ -0,0 +1,168 @@
+#include <catch2/catch_test_macros.hpp>
+#include <array>
+#include <list>
+#include <ranges>
+#include <result/ranges.hpp>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace result;
+
+namespace {
+    Result<int, std::string> parse_digit(char c) {
+        if (c >= '0' && c <= '9') {
+            return Ok {c - '0'};
+        }
+        return Error {std::string("not a digit: ") + c};
+    }
+
+    // Counts how often parse is invoked, to observe short-circuiting.
+    struct CountingParse {
+        int* calls;
+
+        Result<int, std::string> operator()(char c) const {
+            ++*calls;
+            return parse_digit(c);
+        }
+    };
+}
+
+TEST_CASE("Collect", "[Ranges]") {
+    SECTION("All Ok values are collected in order") {
+        std::vector<Result<int, std::string>> results {Ok {1}, Ok {2}, Ok {3}};
+        auto collected = collect(results);
+        static_assert(std::is_same_v<decltype(collected), Result<std::vector<int>, std::string>>);
+        REQUIRE(collected.unwrap() == std::vector {1, 2, 3});
+        REQUIRE(collected.unwrap().capacity() == 3);
+    }
+
+    SECTION("The first error is returned and iteration stops there") {
+        int calls = 0;
+        std::string input = "12x4y";
+        auto collected = collect(input | std::views::transform(CountingParse {&calls}));
+        REQUIRE(collected.has_error());
+        REQUIRE(collected.error() == "not a digit: x");
+        REQUIRE(calls == 3);
+    }
+
+    SECTION("Other containers") {
+        std::list<Result<int, std::string>> results {Ok {3}, Ok {1}, Ok {3}};
+        REQUIRE(collect<std::set<int>>(results).unwrap() == std::set {1, 3});
+    }
+
+    SECTION("Owning ranges passed as rvalues give up their values") {
+        std::vector<Result<std::string, int>> results;
+        results.emplace_back(Ok<std::string> {std::string(64, 'a')});
+        auto collected = collect(std::move(results));
+        REQUIRE(collected.unwrap()[0] == std::string(64, 'a'));
+        REQUIRE(results[0].unwrap().empty());
+    }
+
+    SECTION("Views passed as rvalues keep their elements") {
+        std::vector<Result<std::string, int>> results;
+        results.emplace_back(Ok<std::string> {std::string(64, 'a')});
+        auto collected = collect(results | std::views::take(1));
+        REQUIRE(collected.unwrap()[0] == std::string(64, 'a'));
+        REQUIRE(results[0].unwrap() == std::string(64, 'a'));
+    }
+
+    SECTION("Void results sequence to the first error") {
+        std::vector<Result<void, int>> results {Ok<> {}, Error {4}, Error {5}};
+        REQUIRE(collect(results).error() == 4);
+        results.erase(results.begin() + 1, results.end());
+        REQUIRE_FALSE(collect(results).has_error());
+    }
+
+    SECTION("try_collect fills caller storage") {
+        std::array<int, 8> storage {};
+        std::string input = "1234";
+        auto filled = try_collect(input | std::views::transform(parse_digit), std::span<int>(storage));
+        REQUIRE(filled.unwrap().size() == 4);
+        REQUIRE(filled.unwrap().data() == storage.data());
+        REQUIRE(storage[3] == 4);
+
+        input = "9a";
+        REQUIRE(try_collect(input | std::views::transform(parse_digit), std::span<int>(storage)).error() == "not a digit: a");
+    }
+
+    SECTION("try_collect never writes past the output") {
+        std::array<int, 4> storage {};
+        std::span<int> prefix(storage.data(), 2);
+        std::string input = "123";
+        REQUIRE_THROWS_AS(try_collect(input | std::views::transform(parse_digit), prefix), std::length_error);
+        REQUIRE(storage[0] == 0);
+
+        std::list<Result<int, std::string>> unsized {Ok {1}, Ok {2}, Ok {3}};
+        auto digits = unsized | std::views::filter([](const auto&) { return true; });
+        REQUIRE_THROWS_AS(try_collect(digits, prefix), std::length_error);
+        REQUIRE(storage[1] == 2);
+        REQUIRE(storage[2] == 0);
+    }
+}
+
+TEST_CASE("Result views", "[Ranges]") {
+    std::vector<Result<int, std::string>> results {Ok {1}, Error<std::string> {"a"}, Ok {3}, Error<std::string> {"b"}};
+
+    SECTION("Oks and errors") {
+        std::vector<int> oks;
+        for (int& value : results | views::oks) {
+            oks.push_back(value);
+            value *= 10;
+        }
+        REQUIRE(oks == std::vector {1, 3});
+        REQUIRE(results[2].unwrap() == 30);
+
+        std::vector<std::string> errors;
+        for (const std::string& error : views::errors(results)) {
+            errors.push_back(error);
+        }
+        REQUIRE(errors == std::vector<std::string> {"a", "b"});
+    }
+
+    SECTION("Oks of Results produced on the fly") {
+        std::string input = "1x2";
+        std::vector<int> oks;
+        for (int value : input | std::views::transform(parse_digit) | views::oks) {
+            oks.push_back(value);
+        }
+        REQUIRE(oks == std::vector {1, 2});
+    }
+
+    SECTION("until_error includes the error and nothing after it") {
+        std::vector<int> seen;
+        bool saw_error = false;
+        for (const auto& result : results | views::until_error) {
+            if (result.has_error()) {
+                saw_error = true;
+            } else {
+                seen.push_back(*result);
+            }
+        }
+        REQUIRE(seen == std::vector {1});
+        REQUIRE(saw_error);
+    }
+
+    SECTION("transform_result evaluates each element once and stops at the first error") {
+        int calls = 0;
+        std::string input = "12x45";
+        std::vector<int> seen;
+        for (auto& result : input | views::transform_result(CountingParse {&calls})) {
+            if (result.has_value()) {
+                seen.push_back(*result);
+            }
+        }
+        REQUIRE(seen == std::vector {1, 2});
+        REQUIRE(calls == 3);
+
+        calls = 0;
+        auto digits = views::transform_result(input, CountingParse {&calls}) | views::oks;
+        REQUIRE(std::ranges::distance(digits) == 2);
+        REQUIRE(calls == 3);
+
+        calls = 0;
+        REQUIRE(collect(input | views::transform_result(CountingParse {&calls})).error() == "not a digit: x");
+        REQUIRE(calls == 3);
+    }
+}
@@ -0,0 +1,130 @@
+#include <catch2/catch_test_macros.hpp>
+#include <result/result_vector.hpp>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace result;
+
+TEST_CASE("ResultVector", "[ResultVector]") {
+    SECTION("Push and positional access") {
+        ResultVector<int, std::string> results;
+        results.push_ok(1);
+        results.push_error("bad");
+        results.push_ok(3);
+
+        REQUIRE(results.size() == 3);
+        REQUIRE(results.ok_count() == 2);
+        REQUIRE(results.error_count() == 1);
+        REQUIRE(results.has_value(0));
+        REQUIRE(results.has_error(1));
+        REQUIRE(results.value(2) == 3);
+        REQUIRE(results.error(1) == "bad");
+        REQUIRE(results.get(1).error() == "bad");
+        REQUIRE(results.get(2).unwrap() == 3);
+    }
+
+    SECTION("Oks are dense and errors keep their positions") {
+        ResultVector<int, std::string> results;
+        for (int i = 0; i < 200; ++i) {
+            if (i % 7 == 0) {
+                results.push_error("error " + std::to_string(i));
+            } else {
+                results.push_ok(i);
+            }
+        }
+
+        int expected_sum = 0;
+        for (int i = 0; i < 200; ++i) {
+            if (i % 7 != 0) {
+                expected_sum += i;
+                REQUIRE(results.value(i) == i);
+            } else {
+                REQUIRE(results.error(i) == "error " + std::to_string(i));
+            }
+        }
+
+        int sum = 0;
+        for (int value : results.oks()) {
+            sum += value;
+        }
+        REQUIRE(sum == expected_sum);
+        REQUIRE(results.errors().size() == 29);
+        REQUIRE(results.errors()[1].index == 7);
+    }
+
+    SECTION("Values can be updated in place") {
+        ResultVector<std::string, int> results;
+        results.push_error(5);
+        results.push_ok("value");
+        results.value(1) += "s";
+        results.error(0) += 1;
+        REQUIRE(results.value(1) == "values");
+        REQUIRE(results.error(0) == 6);
+    }
+
+    SECTION("Conversion to and from std::vector") {
+        std::vector<Result<int, std::string>> source;
+        for (int i = 0; i < 130; ++i) {
+            if (i % 3 == 0) {
+                source.emplace_back(Error<std::string> {std::to_string(i)});
+            } else {
+                source.emplace_back(Ok<int> {i});
+            }
+        }
+
+        ResultVector<int, std::string> results(source);
+        REQUIRE(results.size() == source.size());
+
+        std::vector<Result<int, std::string>> round_trip = results.to_vector();
+        REQUIRE(round_trip.size() == source.size());
+        for (std::size_t i = 0; i < source.size(); ++i) {
+            REQUIRE(round_trip[i].has_value() == source[i].has_value());
+            if (source[i].has_value()) {
+                REQUIRE(*round_trip[i] == *source[i]);
+            } else {
+                REQUIRE(round_trip[i].error() == source[i].error());
+            }
+        }
+
+        std::vector<Result<int, std::string>> moved = std::move(results).to_vector();
+        REQUIRE(moved.size() == source.size());
+        REQUIRE(moved[3].error() == "3");
+    }
+
+    SECTION("Status words mark successful positions") {
+        ResultVector<int, int> results;
+        results.push_ok(0);
+        results.push_error(1);
+        results.push_ok(2);
+        REQUIRE(results.status_words().size() == 1);
+        REQUIRE(results.status_words()[0] == 0b101);
+    }
+
+    SECTION("A throwing push leaves the container unchanged") {
+        struct Checked {
+            int value;
+            explicit Checked(int v) : value(v) {
+                if (v < 0) {
+                    throw std::invalid_argument("negative");
+                }
+            }
+        };
+
+        ResultVector<Checked, std::string> results;
+        for (int i = 0; i < 64; ++i) {
+            results.push_ok(i);
+        }
+        // Both pushes would start a new status word.
+        REQUIRE_THROWS_AS(results.push_ok(-1), std::invalid_argument);
+        REQUIRE_THROWS_AS(results.push_error(std::string::npos, 'x'), std::length_error);
+        REQUIRE(results.size() == 64);
+        REQUIRE(results.status_words().size() == 1);
+
+        results.push_error("bad");
+        results.push_ok(65);
+        REQUIRE(results.has_error(64));
+        REQUIRE(results.value(65).value == 65);
+        REQUIRE(results.ok_count() == 65);
+    }
+}
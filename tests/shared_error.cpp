@@ -0,0 +1,122 @@
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <result/shared_error.hpp>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace result;
+
+namespace {
+    struct Tracked {
+        static inline int copies = 0;
+        static inline int moves = 0;
+
+        std::string message;
+
+        explicit Tracked(std::string text) : message(std::move(text)) {}
+        Tracked(const Tracked& other) : message(other.message) { ++copies; }
+        Tracked(Tracked&& other) noexcept : message(std::move(other.message)) { ++moves; }
+
+        bool operator==(const Tracked& other) const { return message == other.message; }
+    };
+
+    int increment(int value) { return value + 1; }
+}
+
+static_assert(sizeof(SharedError<std::string>) == sizeof(void*));
+static_assert(sizeof(Result<int, SharedError<std::string>>) == 2 * sizeof(void*));
+static_assert(std::is_nothrow_copy_constructible_v<Result<int, SharedError<std::string>>>);
+
+TEST_CASE("const& combinators copy the untouched side once", "[SharedError]") {
+    Tracked::copies = 0;
+    const Result<int, Tracked> failed = Error {Tracked("disk full")};
+    Tracked::moves = 0;
+    auto mapped = failed.map(increment);
+    REQUIRE(mapped.error().message == "disk full");
+    REQUIRE(Tracked::copies == 1);
+    REQUIRE(Tracked::moves == 0);
+
+    const Result<Tracked, int> succeeded = Ok {Tracked("value")};
+    Tracked::copies = 0;
+    Tracked::moves = 0;
+    auto unchanged = succeeded.map_error(increment);
+    REQUIRE(unchanged.unwrap().message == "value");
+    REQUIRE(Tracked::copies == 1);
+    REQUIRE(Tracked::moves == 0);
+}
+
+TEST_CASE("SharedError", "[SharedError]") {
+    SECTION("Copies share the error") {
+        Tracked::copies = 0;
+        SharedError<Tracked> error = Tracked("disk full");
+        SharedError<Tracked> copy = error;
+        REQUIRE(error.use_count() == 2);
+        REQUIRE(&*copy == &*error);
+        REQUIRE(copy->message == "disk full");
+        REQUIRE(Tracked::copies == 0);
+
+        SharedError<Tracked> moved = std::move(copy);
+        REQUIRE(copy.use_count() == 0);
+        REQUIRE(moved.use_count() == 2);
+
+        copy = moved;
+        REQUIRE(error.use_count() == 3);
+        moved = SharedError<Tracked>(std::in_place, "other");
+        REQUIRE(error.use_count() == 2);
+        REQUIRE(moved->message == "other");
+    }
+
+    SECTION("Comparison") {
+        SharedError<std::string> error = std::string("disk full");
+        REQUIRE(error == SharedError<std::string>(std::string("disk full")));
+        REQUIRE(error == std::string("disk full"));
+        REQUIRE_FALSE(error == std::string("disk empty"));
+    }
+
+    SECTION("Propagating through const& combinators does not copy the error") {
+        Tracked::copies = 0;
+        const Result<int, SharedError<Tracked>> failed = Error<SharedError<Tracked>> {Tracked("disk full")};
+        const auto first = failed.map(increment);
+        const auto second = first.map(increment);
+        const auto third = second.map(increment);
+        const auto fourth = third.map(increment);
+        const auto fifth = fourth.map(increment);
+
+        REQUIRE(&*fifth.error() == &*failed.error());
+        REQUIRE(failed.error().use_count() == 6);
+        REQUIRE(Tracked::copies == 0);
+    }
+
+    SECTION("Descriptions of the shared error are used") {
+        Result<int, SharedError<std::string>> failed = Error<SharedError<std::string>> {std::string("disk full")};
+        try {
+            (void)failed.unwrap();
+            FAIL("unwrap() did not throw");
+        } catch (const std::exception& exception) {
+            REQUIRE(std::string_view(exception.what()) == "Failed to unwrap Result: disk full");
+        }
+    }
+
+    SECTION("Copies on other threads") {
+        SharedError<std::string> error = std::string("shared");
+        std::atomic<bool> shared {true};
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 4; ++i) {
+            threads.emplace_back([&] {
+                for (int j = 0; j < 1000; ++j) {
+                    SharedError<std::string> copy = error;
+                    if (copy.use_count() < 2 || &*copy != &*error) {
+                        shared = false;
+                    }
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        REQUIRE(shared);
+        REQUIRE(error.use_count() == 1);
+    }
+}
@@ -0,0 +1,111 @@
+#include <catch2/catch_test_macros.hpp>
+#include <mutex>
+#include <result/result.hpp>
+#include <result/stats.hpp>
+#include <string>
+#include <string_view>
+#include <thread>
+
+// Built as its own executable with RESULT_ENABLE_STATS defined.
+static_assert(result::stats::enabled);
+
+using namespace result;
+
+namespace {
+    enum class IoError { NotFound };
+
+    Result<int, IoError> open_file(bool fail) {
+        if (fail) {
+            return Error {IoError::NotFound};
+        }
+        return Ok {1};
+    }
+
+    constexpr Result<int, int> constant_error() { return Error {3}; }
+    static_assert(constant_error().error() == 3);
+
+    std::uint64_t total(const stats::Snapshot& snapshot, stats::Event event, std::string_view type) {
+        std::uint64_t sum = 0;
+        for (const stats::Counter& counter : snapshot.counters) {
+            if (counter.event == event && counter.type.find(type) != std::string_view::npos) {
+                sum += counter.count;
+            }
+        }
+        return sum;
+    }
+}
+
+TEST_CASE("Error statistics", "[Stats]") {
+    stats::reset();
+
+    SECTION("Errors are counted per type and call site") {
+        for (int i = 0; i < 10; ++i) {
+            (void)open_file(i % 2 == 0);
+        }
+        stats::Snapshot snapshot = stats::snapshot();
+        REQUIRE(snapshot.counters.size() == 1);
+        const stats::Counter& counter = snapshot.counters[0];
+        REQUIRE(counter.event == stats::Event::ErrorConstructed);
+        REQUIRE(counter.type.find("IoError") != std::string_view::npos);
+        REQUIRE(counter.file.ends_with("stats.cpp"));
+        REQUIRE(counter.line == 19);
+        REQUIRE(counter.count == 5);
+    }
+
+    SECTION("Failed unwraps and misused error() are counted where they happen") {
+        Result<int, IoError> failed = open_file(true);
+        Result<int, IoError> succeeded = open_file(false);
+        std::uint_least32_t unwrap_line = __LINE__ + 1;
+        REQUIRE_THROWS(failed.unwrap());
+        REQUIRE_THROWS(succeeded.error());
+        REQUIRE_THROWS(std::move(succeeded).error());
+
+        stats::Snapshot snapshot = stats::snapshot();
+        REQUIRE(total(snapshot, stats::Event::UnwrapFailed, "IoError") == 1);
+        REQUIRE(total(snapshot, stats::Event::BadErrorAccess, "IoError") == 2);
+        for (const stats::Counter& counter : snapshot.counters) {
+            if (counter.event == stats::Event::UnwrapFailed) {
+                REQUIRE(counter.line == unwrap_line);
+            }
+        }
+    }
+
+    SECTION("Counts of other threads, including exited ones, are aggregated") {
+        std::thread worker([] {
+            for (int i = 0; i < 100; ++i) {
+                (void)open_file(true);
+            }
+        });
+        worker.join();
+        (void)open_file(true);
+
+        stats::Snapshot snapshot = stats::snapshot();
+        REQUIRE(snapshot.counters.size() == 1);
+        REQUIRE(snapshot.counters[0].count == 101);
+    }
+
+    SECTION("A thread registers one table for all error types") {
+        auto live_tables = [] {
+            std::lock_guard lock(stats::detail::registry().mutex);
+            return stats::detail::registry().tables.size();
+        };
+        std::size_t before = 0;
+        std::size_t after = 0;
+        std::thread worker([&] {
+            before = live_tables();
+            (void)Error {IoError::NotFound};
+            (void)Error {1};
+            (void)Error {std::string("failed")};
+            after = live_tables();
+        });
+        worker.join();
+        REQUIRE(after == before + 1);
+        REQUIRE(total(stats::snapshot(), stats::Event::ErrorConstructed, "") == 3);
+    }
+
+    SECTION("reset() clears every counter") {
+        (void)open_file(true);
+        stats::reset();
+        REQUIRE(stats::snapshot().counters.empty());
+    }
+}
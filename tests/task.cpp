@@ -0,0 +1,186 @@
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <result/task.hpp>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <variant>
+#include <vector>
+
+using namespace result;
+
+namespace {
+    Result<int, std::string> parse_number(const std::string& text) {
+        if (text.empty() || text.find_first_not_of("0123456789") != std::string::npos) {
+            return Error<std::string> {"not a number: " + text};
+        }
+        return Ok<int> {std::stoi(text)};
+    }
+
+    Task<Result<int, std::string>> parse_async(ThreadPool& pool, std::string text) {
+        co_await pool.schedule();
+        co_return parse_number(text);
+    }
+
+    Task<Result<int, std::string>> sum_async(ThreadPool& pool, std::string a, std::string b) {
+        int x = co_await co_await parse_async(pool, a);
+        int y = co_await co_await parse_async(pool, b);
+        co_return Ok {x + y};
+    }
+
+    // Keeps rescheduling itself; counts the steps it gets to run before being cancelled.
+    Task<Result<int, std::string>> spin(ThreadPool& pool, std::atomic<int>& steps, int count) {
+        for (int i = 0; i < count; ++i) {
+            co_await pool.schedule();
+            steps.fetch_add(1, std::memory_order_relaxed);
+        }
+        co_return Ok {count};
+    }
+
+    Task<Result<int, std::string>> spin_nested(ThreadPool& pool, std::atomic<int>& steps, int count) {
+        int inner = co_await co_await spin(pool, steps, count);
+        co_return Ok {inner + 1};
+    }
+
+    Task<Result<int, std::string>> fail_after(ThreadPool& pool, int hops, std::string message) {
+        for (int i = 0; i < hops; ++i) {
+            co_await pool.schedule();
+        }
+        co_return Error {std::move(message)};
+    }
+
+    Task<Result<void, std::string>> record(ThreadPool& pool, std::atomic<int>& count, std::string text) {
+        co_await pool.schedule();
+        co_await parse_number(text);
+        count.fetch_add(1, std::memory_order_relaxed);
+        co_return Ok<> {};
+    }
+}
+
+TEST_CASE("Tasks", "[Task]") {
+    ThreadPool pool(4);
+
+    SECTION("Tasks are lazy and complete with their Result") {
+        bool started = false;
+        auto task = [](bool& flag) -> Task<Result<int, std::string>> {
+            flag = true;
+            co_return Ok {7};
+        }(started);
+        REQUIRE_FALSE(started);
+        REQUIRE(sync_wait(std::move(task)).unwrap() == 7);
+        REQUIRE(started);
+    }
+
+    SECTION("Awaiting Results unwraps them or short-circuits") {
+        REQUIRE(sync_wait(sum_async(pool, "20", "22")).unwrap() == 42);
+        REQUIRE(sync_wait(sum_async(pool, "20", "x")).error() == "not a number: x");
+    }
+
+    SECTION("schedule() moves the task onto a worker") {
+        auto task = [](ThreadPool& pool) -> Task<Result<std::thread::id, int>> {
+            co_await pool.schedule();
+            co_return Ok {std::this_thread::get_id()};
+        }(pool);
+        REQUIRE(sync_wait(std::move(task)).unwrap() != std::this_thread::get_id());
+    }
+
+    SECTION("Exceptions are rethrown by the awaiter") {
+        auto task = [](ThreadPool& pool) -> Task<Result<void, int>> {
+            co_await pool.schedule();
+            throw std::runtime_error("boom");
+        }(pool);
+        REQUIRE_THROWS_AS(sync_wait(std::move(task)), std::runtime_error);
+    }
+}
+
+TEST_CASE("Task joins", "[Task]") {
+    ThreadPool pool(4);
+
+    SECTION("when_all collects every value") {
+        auto joined = sync_wait(when_all(parse_async(pool, "1"), parse_async(pool, "2"), sum_async(pool, "3", "4")));
+        REQUIRE(joined.unwrap() == std::tuple {1, 2, 7});
+
+        std::vector<Task<Result<int, std::string>>> tasks;
+        for (int i = 0; i < 1000; ++i) {
+            tasks.push_back(parse_async(pool, std::to_string(i)));
+        }
+        auto values = sync_wait(when_all(std::move(tasks))).unwrap();
+        REQUIRE(values.size() == 1000);
+        REQUIRE(values[999] == 999);
+    }
+
+    SECTION("when_all accepts Result<void> tasks") {
+        std::atomic<int> count {0};
+        auto mixed = sync_wait(when_all(parse_async(pool, "1"), record(pool, count, "2"), parse_async(pool, "3")));
+        REQUIRE(mixed.unwrap() == std::tuple {1, std::monostate {}, 3});
+
+        Result<void, std::string> all_void = sync_wait(when_all(record(pool, count, "4"), record(pool, count, "5")));
+        REQUIRE_FALSE(all_void.has_error());
+        REQUIRE(count.load() == 3);
+
+        std::vector<Task<Result<void, std::string>>> tasks;
+        tasks.push_back(record(pool, count, "6"));
+        tasks.push_back(record(pool, count, "x"));
+        Result<void, std::string> failed = sync_wait(when_all(std::move(tasks)));
+        REQUIRE(failed.error() == "not a number: x");
+    }
+
+    SECTION("when_all returns the first error and cancels its siblings") {
+        std::atomic<int> steps {0};
+        std::vector<Task<Result<int, std::string>>> tasks;
+        tasks.push_back(spin(pool, steps, 1'000'000));
+        tasks.push_back(fail_after(pool, 3, "disk error"));
+        tasks.push_back(spin_nested(pool, steps, 1'000'000));
+        auto joined = sync_wait(when_all(std::move(tasks)));
+        REQUIRE(joined.error() == "disk error");
+        REQUIRE(steps.load() < 1'000'000);
+    }
+
+    SECTION("Stopping an outer join reaches tasks inside an inner one") {
+        std::atomic<int> steps {0};
+        auto joined = sync_wait(when_all(when_all(spin(pool, steps, 1'000'000), spin_nested(pool, steps, 1'000'000)),
+                                         fail_after(pool, 10, "outer")));
+        REQUIRE(joined.error() == "outer");
+        REQUIRE(steps.load() < 1'000'000);
+    }
+
+    SECTION("when_any returns the first Ok and cancels its siblings") {
+        std::atomic<int> steps {0};
+        std::vector<Task<Result<int, std::string>>> tasks;
+        tasks.push_back(fail_after(pool, 0, "fast failure"));
+        tasks.push_back(spin(pool, steps, 1'000'000));
+        tasks.push_back(parse_async(pool, "5"));
+        REQUIRE(sync_wait(when_any(std::move(tasks))).unwrap() == 5);
+        REQUIRE(steps.load() < 1'000'000);
+    }
+
+    SECTION("when_any fails only if every task fails") {
+        std::vector<Task<Result<int, std::string>>> tasks;
+        tasks.push_back(fail_after(pool, 5, "slow"));
+        tasks.push_back(fail_after(pool, 0, "fast"));
+        REQUIRE(sync_wait(when_any(std::move(tasks))).error() == "fast");
+    }
+
+    SECTION("when_any of no tasks fails when awaited") {
+        auto any = when_any(std::vector<Task<Result<int, std::string>>> {});
+        REQUIRE_THROWS_AS(sync_wait(std::move(any)), std::invalid_argument);
+    }
+
+    SECTION("cancellation_point ends a stopped task") {
+        std::atomic<int> steps {0};
+        auto busy = [](std::atomic<int>& steps) -> Task<Result<int, std::string>> {
+            for (;;) {
+                co_await cancellation_point();
+                steps.fetch_add(1, std::memory_order_relaxed);
+                std::this_thread::yield();
+            }
+        };
+        auto wrapped = [](ThreadPool& pool, auto busy, std::atomic<int>& steps) -> Task<Result<int, std::string>> {
+            co_await pool.schedule();
+            co_return co_await busy(steps);
+        };
+        auto joined = sync_wait(when_all(wrapped(pool, busy, steps), fail_after(pool, 20, "stop")));
+        REQUIRE(joined.error() == "stop");
+    }
+}